@@ -0,0 +1,182 @@
+/*!	@brief Analog inputs
+ *
+ *	In free running mode the next conversion has already started
+ *	when the conversion complete interrupt runs, so a new channel
+ *	selection only applies to the conversion after that. The ISR
+ *	keeps track of which channel each conversion belongs to.
+ *
+ *	At 16MHz with a /128 ADC clock, each of n enabled channels
+ *	gets a new value about 9600 / (16 * n) times per second.
+ *
+ *	@author inselc
+ *	@date 19.10.26			First implementation					*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#include "../../modules/adc/adc.h"
+#include "Analog.h"
+
+#if (ANALOG_OVERSAMPLING & (ANALOG_OVERSAMPLING - 1)) || (ANALOG_OVERSAMPLING > 64)
+#error "ANALOG_OVERSAMPLING must be a power of two, up to 64"
+#endif
+
+#define ANALOG_MAX_VALUE		1023
+
+static volatile uint8_t analogChannels = 0;			//!< Enabled channels
+static volatile uint8_t analogChanged = 0;			//!< Channels with a new value
+static uint16_t analogValues[ANALOG_MAX_CHANNELS];	//!< Reported values
+static uint16_t analogSums[ANALOG_MAX_CHANNELS];	//!< Oversampling accumulators
+static uint8_t analogCounts[ANALOG_MAX_CHANNELS];	//!< Samples in accumulators
+static uint8_t analogCompleting = 0;	//!< Channel of the conversion completing next
+static uint8_t analogRunning = 0;		//!< Channel of the conversion after that
+
+/*!	@brief Get the next enabled channel
+ *
+ *	@param[in] channel		Current channel
+ *	@return uint8_t			Next enabled channel
+ *	@date 19.10.26			First implementation					*/
+static inline uint8_t analogNextChannel(uint8_t channel)
+{
+	for (uint8_t i = 0; i < ANALOG_MAX_CHANNELS; ++i)
+	{
+		channel = (channel + 1) & (ANALOG_MAX_CHANNELS - 1);
+		if (analogChannels & (1 << channel))
+			break;
+	}
+	return channel;
+}
+
+/*!	@brief Initialise the analog input module
+ *
+ *	@date 19.10.26			First implementation					*/
+void analogInit(void)
+{
+	adcInit(ADC_REF_AVCC);
+	analogChannels = 0;
+	analogChanged = 0;
+}
+
+/*!	@brief Start converting an analog channel
+ *
+ *	@param[in] channel		ADC channel
+ *	@date 19.10.26			First implementation					*/
+void analogEnableChannel(uint8_t channel)
+{
+	if (channel >= ANALOG_MAX_CHANNELS)
+		return;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		analogSums[channel] = 0;
+		analogCounts[channel] = 0;
+		analogValues[channel] = 0;
+		adcDisableDigitalInput(channel);
+
+		if (analogChannels == 0)
+		{
+			// First channel, start the ADC
+			analogCompleting = channel;
+			analogRunning = channel;
+			adcSetChannel(channel);
+			analogChannels = 1 << channel;
+			adcStartFreeRunning(ADC_CLK_PRESC_DIV_128);
+		}
+		else
+		{
+			analogChannels |= 1 << channel;
+		}
+	}
+}
+
+/*!	@brief Stop converting an analog channel
+ *
+ *	The ADC is stopped with the last channel.
+ *
+ *	@param[in] channel		ADC channel
+ *	@date 19.10.26			First implementation					*/
+void analogDisableChannel(uint8_t channel)
+{
+	if (channel >= ANALOG_MAX_CHANNELS)
+		return;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		analogChannels &= ~(1 << channel);
+		analogChanged &= ~(1 << channel);
+		if (analogChannels == 0)
+			adcStop();
+	}
+}
+
+/*!	@brief Take the set of channels with new values
+ *
+ *	@return uint8_t			Bit mask of changed channels
+ *	@date 19.10.26			First implementation					*/
+uint8_t analogGetChanged(void)
+{
+	uint8_t changed;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		changed = analogChanged;
+		analogChanged = 0;
+	}
+	return changed;
+}
+
+/*!	@brief Get the value of an analog channel
+ *
+ *	@param[in] channel		ADC channel
+ *	@return uint16_t		Averaged value (0..1023)
+ *	@date 19.10.26			First implementation					*/
+uint16_t analogRead(uint8_t channel)
+{
+	uint16_t value = 0;
+
+	if (channel >= ANALOG_MAX_CHANNELS)
+		return 0;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		value = analogValues[channel];
+	}
+	return value;
+}
+
+// -----------------------------------------------------------------
+
+/*!	@brief ADC Conversion Complete ISR: oversampling and hysteresis
+ *
+ *	@date 19.10.26			First implementation					*/
+ISR(ADC_vect)
+{
+	uint16_t sample = ADC;
+	uint8_t channel = analogCompleting;
+
+	// Select the channel for the conversion after the running one
+	analogCompleting = analogRunning;
+	analogRunning = analogNextChannel(analogRunning);
+	adcSetChannel(analogRunning);
+
+	if ((analogChannels & (1 << channel)) == 0)
+		return;
+
+	analogSums[channel] += sample;
+	if (++analogCounts[channel] < ANALOG_OVERSAMPLING)
+		return;
+
+	uint16_t value = analogSums[channel] / ANALOG_OVERSAMPLING;
+	analogSums[channel] = 0;
+	analogCounts[channel] = 0;
+
+	// Report changes past the hysteresis, and reaching either end
+	if ((abs((int16_t)value - (int16_t)analogValues[channel]) > ANALOG_HYSTERESIS) ||
+		((value != analogValues[channel]) && ((value == 0) || (value == ANALOG_MAX_VALUE))))
+	{
+		analogValues[channel] = value;
+		analogChanged |= 1 << channel;
+	}
+}
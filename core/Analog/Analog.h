@@ -0,0 +1,29 @@
+/*!	@brief Analog inputs
+ *
+ *	The ADC runs free, converting all enabled channels in turn.
+ *	Samples are averaged per channel, and a channel's value is only
+ *	updated - and reported as changed - once the average moves by
+ *	more than the hysteresis.
+ *
+ *	@author inselc
+ *	@date 19.10.26			First implementation					*/
+
+#ifndef ANALOG_H_
+#define ANALOG_H_
+
+/*!	@file */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ANALOG_MAX_CHANNELS		8		/* ADC0..7 */
+#define ANALOG_OVERSAMPLING		16		/* Samples per value, power of two, up to 64 */
+#define ANALOG_HYSTERESIS		4		/* Minimum change of a value, in ADC counts */
+
+void analogInit(void);
+void analogEnableChannel(uint8_t channel);
+void analogDisableChannel(uint8_t channel);
+uint8_t analogGetChanged(void);
+uint16_t analogRead(uint8_t channel);
+
+#endif /* ANALOG_H_ */
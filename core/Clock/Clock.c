@@ -0,0 +1,47 @@
+/*!	@brief System millisecond clock
+ *
+ *	Timer 2 runs in CTC mode at F_CPU / 64 and overflows every 250
+ *	ticks, i.e. once per millisecond at 16MHz.
+ *
+ *	@author inselc
+ *	@date 19.10.26			First implementation					*/
+
+#include <stdint.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "../../modules/timer/timer.h"
+#include "Clock.h"
+
+#define CLOCK_TICKS_PER_MS	250		/* 16MHz / 64 / 1kHz			*/
+
+volatile uint32_t clockMilliseconds = 0;	//!< Milliseconds since init
+
+/*!	@brief Initialise the system clock
+ *
+ *	@note Requires interrupts to be enabled.
+ *
+ *	@date 19.10.26			First implementation					*/
+void clockInit(void)
+{
+	timer2Init();
+	clockMilliseconds = 0;
+
+	// 1ms period
+	timer2SetCompareA(CLOCK_TICKS_PER_MS - 1);
+
+	// Enable Timer 2 Compare A interrupt
+	TIMSK2 |= 1 << OCIE2A;
+
+	// 64 prescale, Clear timer on OCRA match
+	timer2Start(TMR2_CLK_PRESC_DIV_64, TMR2_WG_CTC);
+}
+
+// -----------------------------------------------------------------
+
+/*!	@brief Timer 2 Compare Match ISR: millisecond tick
+ *
+ *	@date 19.10.26			First implementation					*/
+ISR(TIMER2_COMPA_vect)
+{
+	++clockMilliseconds;
+}
@@ -0,0 +1,50 @@
+/*!	@brief System millisecond clock
+ *
+ *	Free-running millisecond counter, driven by Timer 2 in CTC mode.
+ *
+ *	@author inselc
+ *	@date 19.10.26			First implementation					*/
+
+#ifndef CLOCK_H_
+#define CLOCK_H_
+
+/*!	@file */
+
+#include <stdint.h>
+#include <util/atomic.h>
+
+extern volatile uint32_t clockMilliseconds;
+
+void clockInit(void);
+
+/*!	@brief Get milliseconds since clockInit
+ *
+ *	@return uint32_t		Millisecond count (wraps after ~49 days)
+ *	@date 19.10.26			First implementation					*/
+static inline uint32_t clockMillis(void)
+{
+	uint32_t ms;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		ms = clockMilliseconds;
+	}
+	return ms;
+}
+
+/*!	@brief Get the lower 16 bits of the millisecond count
+ *
+ *	Cheaper than clockMillis, for short intervals and timestamps.
+ *
+ *	@return uint16_t		Millisecond count (wraps after ~65s)
+ *	@date 19.10.26			First implementation					*/
+static inline uint16_t clockMillis16(void)
+{
+	uint16_t ms;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		ms = (uint16_t)clockMilliseconds;
+	}
+	return ms;
+}
+
+#endif /* CLOCK_H_ */
@@ -1,20 +1,65 @@
 /*!	@brief Dimmer functionality using bit angle modulation, control-
  *	              ling pins directly connected to the MCU.
  *
- *	This dimmer module uses Timer 0 and Output Compare module A 
+ *	This dimmer module uses Timer 0 and Output Compare module A
  *	to modulate the output signals.
  *
+ *	The channel values are not read by the ISR. dimmerUpdate sorts
+ *	them into one bit plane per value bit and port, so the ISR only
+ *	writes one prepared byte per port and bit: its run time depends
+ *	on the number of ports used, not on the number of channels.
+ *	Bit planes are double buffered and swapped at the start of a BAM
+ *	cycle, so a cycle never mixes old and new values.
+ *
+ *	The 74HC595 backend shifts the plane of the next bit into the
+ *	register chain over the USART in master SPI mode, while the
+ *	current bit is shown, and latches it at the next bit boundary.
+ *	At 8MHz a register takes 16 CPU cycles, well within the shortest
+ *	bit time of 512 cycles even for long chains. The SPI module stays
+ *	free for the W5100.
+ *
+ *	With DIMMER_DITHER, every cycle ends with a dither slot as long as
+ *	bit 0. The ISR prepares its plane during bit 7 from the channel
+ *	fractions: each channel adds its fraction to an error accumulator,
+ *	and is on in the dither slot whenever the accumulator overflows.
+ *	So a channel shows its value plus its fraction in 1/256, averaged
+ *	over cycles, at a few cycles per channel with a fraction and cycle.
+ *
+ *	The PCA9685 backend is implemented in DimmerPCA9685.c, the
+ *	phase-cut backend in DimmerPhase.c.
+ *
  *	@author inselc
- *	@date 28.04.17			First implementation					*/
+ *	@date 28.04.17			First implementation
+ *	@date 19.10.26			Bit planes per port
+ *	@date 19.10.26			74HC595 shift register backend
+ *	@date 19.10.26			Excluded from PCA9685 builds
+ *	@date 19.10.26			Excluded from phase-cut builds
+ *	@date 19.10.26			Temporal dithering						*/
 
 #include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
 #include <avr/interrupt.h>
+#include <util/atomic.h>
 #include "../../modules/timer/timer.h"
+#if defined(CONF_DIMMER_USE_HC595)
+#include "../../modules/usart/usart_spi.h"
+#endif
 #include "Dimmer.h"
 
+#if !defined(CONF_DIMMER_USE_PCA9685) && !defined(CONF_DIMMER_USE_PHASE)
+
+#define DIMMER_BITS			8
+#define DIMMER_PORT_NONE	0xFF
+#if defined(DIMMER_DITHER)
+#define DIMMER_SLOTS		(DIMMER_BITS + 1)	/* Bit planes, then the dither plane */
+#else
+#define DIMMER_SLOTS		DIMMER_BITS
+#endif
+
 /*!	@brief Precalculated Output Compare Register values for
  *	       bit angle modulation										*/
-static const uint8_t dimmerBitAngleTimings[8] = {
+static const uint8_t dimmerBitAngleTimings[DIMMER_SLOTS] = {
 	0x01,
 	0x03,
 	0x07,
@@ -22,30 +67,186 @@ static const uint8_t dimmerBitAngleTimings[8] = {
 	0x1F,
 	0x3F,
 	0x7F,
-	0xFF
+	0xFF,
+#if defined(DIMMER_DITHER)
+	0x01
+#endif
 };
 volatile static uint8_t dimmerCurrentBit = 0;				//!< Currently displayed bit
 static pin_t** dimmerOutputs = NULL;						//!< Array of output pin descriptions
 static uint8_t* dimmerValues;								//!< Corresponding channel values
 static uint8_t dimmerOutputsCount = 0;						//!< Number of channels
 
+#if !defined(CONF_DIMMER_USE_HC595)
+static volatile uint8_t* dimmerPorts[DIMMER_MAX_PORTS];		//!< Output registers of the used ports
+static uint8_t dimmerPortMasks[DIMMER_MAX_PORTS];			//!< Output pins, by used port
+static uint8_t dimmerPortCount = 0;							//!< Number of used ports
+static uint8_t dimmerChannelPorts[DIMMER_MAX_CHANNELS];		//!< Port index, by channel
+#endif
+
+/*!	@brief Bit planes [buffer][bit][port or register, in shift order]	*/
+static uint8_t dimmerPlanes[2][DIMMER_BITS][DIMMER_PLANE_SIZE];
+static volatile uint8_t dimmerFront = 0;					//!< Buffer shown by the ISR
+static volatile bool dimmerPending = false;					//!< Back buffer waits to be shown
+
+#if defined(DIMMER_DITHER)
+static const volatile uint8_t* dimmerFractions = NULL;		//!< Channel fractions, in 1/256
+static uint8_t dimmerDitherErrors[DIMMER_MAX_CHANNELS];		//!< Error accumulators, by channel
+static uint8_t dimmerDitherPlane[DIMMER_PLANE_SIZE];		//!< Plane of the dither slot
+#endif
+
+#if defined(CONF_DIMMER_USE_HC595)
+/*!	@brief Get a channel's byte in the bit planes
+ *
+ *	The byte shifted out first ends up in the last register.
+ *
+ *	@param[in] channel		Channel number
+ *	@return uint8_t			Plane byte index
+ *	@date 19.10.26			First implementation					*/
+static inline uint8_t dimmerChannelLane(uint8_t channel)
+{
+	return DIMMER_PLANE_SIZE - 1 - (channel >> 3);
+}
+
+/*!	@brief Get a channel's bit in its plane byte
+ *
+ *	@param[in] channel		Channel number
+ *	@return uint8_t			Bit mask
+ *	@date 19.10.26			First implementation					*/
+static inline uint8_t dimmerChannelMask(uint8_t channel)
+{
+	return 1 << (channel & 0x07);
+}
+
+/*!	@brief Shift a bit plane into the register chain
+ *
+ *	@param[in] *plane		Bit plane, in shift order
+ *	@date 19.10.26			First implementation					*/
+static inline void dimmerShiftPlane(const uint8_t* plane)
+{
+	for (uint_fast8_t i = 0; i < DIMMER_PLANE_SIZE; ++i)
+	{
+		usartSpiWrite(plane[i]);
+	}
+}
+#else
+static inline uint8_t dimmerChannelLane(uint8_t channel)
+{
+	return dimmerChannelPorts[channel];
+}
+static inline uint8_t dimmerChannelMask(uint8_t channel)
+{
+	return 1 << dimmerOutputs[channel]->Number;
+}
+#endif
+
+#if defined(DIMMER_DITHER)
+/*!	@brief Prepare the plane of the dither slot
+ *
+ *	@date 19.10.26			First implementation					*/
+static inline void dimmerDitherPrepare(void)
+{
+	memset(dimmerDitherPlane, 0, sizeof(dimmerDitherPlane));
+	if (dimmerFractions == NULL)
+		return;
+
+	for (uint_fast8_t i = 0; i < dimmerOutputsCount; ++i)
+	{
+		uint8_t fraction = dimmerFractions[i];
+		if (fraction == 0)
+			continue;
+
+		uint8_t error = dimmerDitherErrors[i] + fraction;
+		if (error < fraction)
+		{
+			// Overflow: one LSB more in this cycle
+			uint8_t lane = dimmerChannelLane(i);
+			if (lane != DIMMER_PORT_NONE)
+				dimmerDitherPlane[lane] |= dimmerChannelMask(i);
+		}
+		dimmerDitherErrors[i] = error;
+	}
+}
+
+/*!	@brief Get the plane of a slot
+ *
+ *	@param[in] slot			Bit number, or DIMMER_BITS for the dither slot
+ *	@return const uint8_t*	Plane
+ *	@date 19.10.26			First implementation					*/
+static inline const uint8_t* dimmerSlotPlane(uint8_t slot)
+{
+	return (slot == DIMMER_BITS) ? dimmerDitherPlane : dimmerPlanes[dimmerFront][slot];
+}
+#else
+static inline const uint8_t* dimmerSlotPlane(uint8_t slot)
+{
+	return dimmerPlanes[dimmerFront][slot];
+}
+#endif
+
 /*!	@brief Initialise the Dimmer module
+ *
+ *	Channels without a pin description (NULL) are skipped. The
+ *	74HC595 backend has fixed outputs and ignores the descriptions.
  *
  *	@param[in] **outputs	Output Pin definitions
  *	@param[in] *values		Channel values
  *	@param[in] outputCount	Number of channels
- *	@date 28.04.17			First implementation					*/
+ *	@date 28.04.17			First implementation
+ *	@date 19.10.26			Group outputs by port
+ *	@date 19.10.26			74HC595 backend							*/
 void dimmerInit(pin_t** outputs, uint8_t* values, int outputCount)
 {
 	// Stop any running timer0
 	timer0Stop();
-	
+
 	// Setup pointers
 	dimmerOutputs = outputs;
-	dimmerOutputsCount = outputCount;
+	dimmerOutputsCount = (outputCount > DIMMER_MAX_CHANNELS) ? DIMMER_MAX_CHANNELS : outputCount;
 	dimmerValues = values;
 	dimmerCurrentBit = 0;
 
+#if defined(CONF_DIMMER_USE_HC595)
+	// Latch idles low, data is latched on its rising edge
+	DIMMER_HC595_LATCH_PORT &= ~(1 << DIMMER_HC595_LATCH_PIN);
+	DIMMER_HC595_LATCH_DDR |= 1 << DIMMER_HC595_LATCH_PIN;
+	usartInitSpiMaster(USART_SPI_MODE0, false, 0);
+#else
+	// Collect the ports used
+	dimmerPortCount = 0;
+	for (uint_fast8_t i = 0; i < dimmerOutputsCount; ++i)
+	{
+		dimmerChannelPorts[i] = DIMMER_PORT_NONE;
+		if (dimmerOutputs[i] == NULL)
+			continue;
+
+		uint8_t port = 0;
+		while ((port < dimmerPortCount) && (dimmerPorts[port] != dimmerOutputs[i]->Port))
+			++port;
+		if (port == dimmerPortCount)
+		{
+			if (dimmerPortCount == DIMMER_MAX_PORTS)
+				continue;
+			dimmerPorts[port] = dimmerOutputs[i]->Port;
+			dimmerPortMasks[port] = 0;
+			++dimmerPortCount;
+		}
+		dimmerPortMasks[port] |= 1 << dimmerOutputs[i]->Number;
+		dimmerChannelPorts[i] = port;
+	}
+#endif
+
+	// Show the initial values from the first cycle on
+	dimmerPending = false;
+	dimmerUpdate();
+	dimmerFront ^= 1;
+	dimmerPending = false;
+
+#if defined(CONF_DIMMER_USE_HC595)
+	// Preload bit 0, latched by the first interrupt
+	dimmerShiftPlane(dimmerPlanes[dimmerFront][0]);
+#endif
+
 	// Initialise Timer 0
 	timer0Init();
 
@@ -60,22 +261,109 @@ void dimmerInit(pin_t** outputs, uint8_t* values, int outputCount)
 	timer0Start(TMR0_CLK_PRESC_DIV_256, TMR0_WG_CTC);
 }
 
+/*!	@brief Prepare the bit planes for changed channel values
+ *
+ *	The new values are shown from the next BAM cycle on. Fails while
+ *	the previous update has not been shown yet; call again later.
+ *
+ *	@return bool			true, if the values were taken
+ *	@date 19.10.26			First implementation					*/
+bool dimmerUpdate(void)
+{
+	if (dimmerPending)
+		return false;
+
+	uint8_t (*planes)[DIMMER_PLANE_SIZE] = dimmerPlanes[dimmerFront ^ 1];
+	memset(planes, 0, sizeof(dimmerPlanes[0]));
+
+	for (uint_fast8_t i = 0; i < dimmerOutputsCount; ++i)
+	{
+		uint8_t lane = dimmerChannelLane(i);
+		if (lane == DIMMER_PORT_NONE)
+			continue;
+
+		uint8_t mask = dimmerChannelMask(i);
+		uint8_t value = dimmerValues[i];
+		for (uint_fast8_t bit = 0; bit < DIMMER_BITS; ++bit)
+		{
+			if (value & (1 << bit))
+				planes[bit][lane] |= mask;
+		}
+	}
+
+	dimmerPending = true;
+	return true;
+}
+
+#if defined(DIMMER_DITHER)
+/*!	@brief Set the channel fractions for temporal dithering
+ *
+ *	The fractions are read by the ISR, once per cycle. They need no
+ *	dimmerUpdate.
+ *
+ *	@param[in] *fractions	Channel fractions, in 1/256 of a step
+ *	@date 19.10.26			First implementation					*/
+void dimmerSetFractions(const uint8_t* fractions)
+{
+	dimmerFractions = fractions;
+}
+#endif
+
 // -----------------------------------------------------------------
 
 /*!	@brief Timer 0 Compare Match ISR: bit angle modulation
  *
  *	@date 28.04.17		First implementation
- *	@date 15.07.17		Added NULL check							*/
+ *	@date 15.07.17		Added NULL check
+ *	@date 19.10.26		Write prepared bit planes per port
+ *	@date 19.10.26		74HC595 backend
+ *	@date 19.10.26		Dither slot									*/
 ISR(TIMER0_COMPA_vect)
 {
-	for (uint_fast8_t i = 0; i < dimmerOutputsCount; ++i)
+	uint8_t bit = dimmerCurrentBit;
+	uint8_t nextBit = (bit + 1) % DIMMER_SLOTS;
+
+#if defined(CONF_DIMMER_USE_HC595)
+	// Show the plane shifted in during the previous interrupt
+	DIMMER_HC595_LATCH_PORT |= 1 << DIMMER_HC595_LATCH_PIN;
+	DIMMER_HC595_LATCH_PORT &= ~(1 << DIMMER_HC595_LATCH_PIN);
+
+	// Take new values at the start of a cycle
+	if ((nextBit == 0) && dimmerPending)
+	{
+		dimmerFront ^= 1;
+		dimmerPending = false;
+	}
+
+#if defined(DIMMER_DITHER)
+	if (nextBit == DIMMER_BITS)
+		dimmerDitherPrepare();
+#endif
+	dimmerShiftPlane(dimmerSlotPlane(nextBit));
+#else
+	// Take new values at the start of a cycle
+	if ((bit == 0) && dimmerPending)
+	{
+		dimmerFront ^= 1;
+		dimmerPending = false;
+	}
+
+	const uint8_t* plane = dimmerSlotPlane(bit);
+	for (uint_fast8_t port = 0; port < dimmerPortCount; ++port)
 	{
-		if (dimmerOutputs[i] != NULL)
-			ioWritePin(dimmerOutputs[i], dimmerValues[i] & (1 << (dimmerCurrentBit)));
+		*dimmerPorts[port] = (*dimmerPorts[port] & ~dimmerPortMasks[port]) | plane[port];
 	}
-	timer0SetCompareA(dimmerBitAngleTimings[dimmerCurrentBit]);
-	
+
+#if defined(DIMMER_DITHER)
+	// Bit 7 is shown long enough to prepare the dither slot
+	if (nextBit == DIMMER_BITS)
+		dimmerDitherPrepare();
+#endif
+#endif
+	timer0SetCompareA(dimmerBitAngleTimings[bit]);
+
 	// Cycle through bits
-	++dimmerCurrentBit;
-	dimmerCurrentBit %= 8;
+	dimmerCurrentBit = nextBit;
 }
+
+#endif /* !CONF_DIMMER_USE_PCA9685 && !CONF_DIMMER_USE_PHASE */
@@ -1,8 +1,35 @@
 /*!	@brief Dimmer functionality using bit angle modulation, control-
  *	              ling pins directly connected to the MCU.
  *
+ *	With CONF_DIMMER_USE_HC595 defined, the channels are driven by a
+ *	chain of CONF_DIMMER_HC595_COUNT 74HC595 shift registers instead:
+ *	SER at TXD (PD1), SRCLK at XCK (PD4), RCLK at PD7. Channel 0 is Q0
+ *	of the first register in the chain. The USART is then no longer
+ *	available as a serial port.
+ *
+ *	With CONF_DIMMER_USE_PCA9685 defined, the channels are driven by
+ *	CONF_DIMMER_PCA9685_COUNT PCA9685 PWM controllers at the TWI bus
+ *	(SDA PC4, SCL PC5), at consecutive addresses from 0x40. Channel 0
+ *	is LED0 of the first controller.
+ *
+ *	Both backends have fixed outputs (DIMMER_FIXED_OUTPUTS): the pin
+ *	descriptions passed to dimmerInit are ignored.
+ *
+ *	With CONF_DIMMER_USE_PHASE defined, the output pins drive triac
+ *	gates (through opto-triacs) for mains phase-cut dimming instead,
+ *	synchronised by a zero-cross detector at INT0 (PD2).
+ *
+ *	With CONF_DIMMER_DITHER defined, the bit angle modulation backends
+ *	(pins and 74HC595) add temporal dithering of channel fractions
+ *	(DIMMER_DITHER), for brightness steps below one value step.
+ *
  *	@author inselc
- *	@date 28.04.17			First implementation					*/
+ *	@date 28.04.17			First implementation
+ *	@date 19.10.26			Bit planes per port
+ *	@date 19.10.26			74HC595 shift register backend
+ *	@date 19.10.26			PCA9685 backend
+ *	@date 19.10.26			Phase-cut backend
+ *	@date 19.10.26			Temporal dithering						*/
 
 #ifndef DIMMER_H_
 #define DIMMER_H_
@@ -10,8 +37,46 @@
 /*!	@file */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "../../modules/io/io.h"
 
+#if defined(CONF_DIMMER_USE_HC595)
+#ifndef CONF_DIMMER_HC595_COUNT
+#define CONF_DIMMER_HC595_COUNT	4		/* Shift registers in the chain */
+#endif
+#define DIMMER_MAX_CHANNELS		(8 * CONF_DIMMER_HC595_COUNT)
+#define DIMMER_PLANE_SIZE		CONF_DIMMER_HC595_COUNT
+#define DIMMER_HC595_LATCH_PORT	PORTD
+#define DIMMER_HC595_LATCH_DDR	DDRD
+#define DIMMER_HC595_LATCH_PIN	PD7
+#define DIMMER_FIXED_OUTPUTS
+#elif defined(CONF_DIMMER_USE_PCA9685)
+#ifndef CONF_DIMMER_PCA9685_COUNT
+#define CONF_DIMMER_PCA9685_COUNT	1	/* Controllers at the bus */
+#endif
+#ifndef CONF_DIMMER_PCA9685_PRESCALE
+#define CONF_DIMMER_PCA9685_PRESCALE	5	/* PWM frequency 25MHz / (4096 * (5 + 1)), ~1kHz */
+#endif
+#define DIMMER_MAX_CHANNELS		(16 * CONF_DIMMER_PCA9685_COUNT)
+#define DIMMER_PCA9685_ADDRESS	0x40	/* Address of the first controller */
+#define DIMMER_FIXED_OUTPUTS
+#elif defined(CONF_DIMMER_USE_PHASE)
+#define DIMMER_MAX_CHANNELS		16		/* Number of channels */
+#define DIMMER_MAX_PORTS		3		/* Number of ports with outputs */
+#else
+#define DIMMER_MAX_CHANNELS		16		/* Number of channels */
+#define DIMMER_MAX_PORTS		3		/* Number of ports with outputs */
+#define DIMMER_PLANE_SIZE		DIMMER_MAX_PORTS
+#endif
+
+#if defined(CONF_DIMMER_DITHER) && !defined(CONF_DIMMER_USE_PCA9685) && !defined(CONF_DIMMER_USE_PHASE)
+#define DIMMER_DITHER
+#endif
+
 void dimmerInit(pin_t** outputs, uint8_t* values, int outputCount);
+bool dimmerUpdate(void);
+#if defined(DIMMER_DITHER)
+void dimmerSetFractions(const uint8_t* fractions);
+#endif
 
-#endif /* DIMMER_H_ */
\ No newline at end of file
+#endif /* DIMMER_H_ */
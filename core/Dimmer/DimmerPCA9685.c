@@ -0,0 +1,181 @@
+/*!	@brief Dimmer functionality using PCA9685 PWM controllers at the
+ *	              TWI bus.
+ *
+ *	The controllers generate the PWM signals themselves, so no timer
+ *	is used. dimmerUpdate compares the channel values against the
+ *	values last sent, and transfers runs of changed channels as one
+ *	write each, using the controller's register auto increment: one
+ *	changed channel costs a 7 byte transfer instead of the 66 bytes
+ *	of a full refresh. Transfers are interrupt-driven and run while
+ *	the main loop goes on; a transfer that fails is repeated.
+ *
+ *	The turn-on times of the channels are staggered over the PWM
+ *	period, to spread the switching current.
+ *
+ *	@author inselc
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Failed transfers by the TWI status		*/
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include "../../modules/twi/twi.h"
+#include "Dimmer.h"
+
+#if defined(CONF_DIMMER_USE_PCA9685)
+
+#define PCA9685_REG_MODE1		0x00
+#define PCA9685_REG_MODE2		0x01
+#define PCA9685_REG_LED0_ON_L	0x06
+#define PCA9685_REG_ALL_OFF_H	0xFD
+#define PCA9685_REG_PRE_SCALE	0xFE
+
+#define PCA9685_MODE1_AI		0x20	/* Register auto increment */
+#define PCA9685_MODE1_SLEEP		0x10	/* Oscillator off */
+#define PCA9685_MODE2_OUTDRV	0x04	/* Totem pole outputs */
+#define PCA9685_FULL			0x10	/* Full on/off bit in LEDn_ON_H/OFF_H */
+
+#define PCA9685_CHANNELS		16		/* Channels per controller */
+#define PCA9685_LED_REGS		4		/* Registers per channel */
+
+static uint8_t* dimmerValues;								//!< Channel values
+static uint8_t dimmerOutputsCount = 0;						//!< Number of channels
+static uint8_t dimmerSent[DIMMER_MAX_CHANNELS];				//!< Values last sent, by channel
+static uint16_t dimmerDirty[CONF_DIMMER_PCA9685_COUNT];		//!< Channels to be sent, by controller
+
+/*!	@brief Transfer buffer: register address, LEDn_ON/OFF registers	*/
+static uint8_t dimmerBuffer[1 + PCA9685_CHANNELS * PCA9685_LED_REGS];
+static uint8_t dimmerBurstChip = 0;							//!< Controller of the last transfer
+static uint16_t dimmerBurstMask = 0;						//!< Channels of the last transfer
+
+/*!	@brief Write registers of a controller, waiting for completion
+ *
+ *	@param[in] chip			Controller index
+ *	@param[in] reg			Register address
+ *	@param[in] value		Register value
+ *	@date 19.10.26			First implementation					*/
+static void dimmerWriteRegister(uint8_t chip, uint8_t reg, uint8_t value)
+{
+	dimmerBuffer[0] = reg;
+	dimmerBuffer[1] = value;
+	twiMasterWrite(DIMMER_PCA9685_ADDRESS + chip, dimmerBuffer, 2);
+	twiMasterWait();
+}
+
+/*!	@brief Fill a channel's LEDn_ON/OFF registers
+ *
+ *	Values are scaled from 8 to 12 bit; 0 and 255 use the full off
+ *	and full on bits.
+ *
+ *	@param[out] *regs		LEDn_ON_L, ON_H, OFF_L, OFF_H
+ *	@param[in] channel		Channel number at the controller
+ *	@param[in] value		Channel value
+ *	@date 19.10.26			First implementation					*/
+static inline void dimmerFillLed(uint8_t* regs, uint8_t channel, uint8_t value)
+{
+	uint16_t on = (uint16_t)channel << 8;
+	uint16_t off = (on + ((uint16_t)value << 4) + (value >> 4)) & 0x0FFF;
+
+	regs[0] = on & 0xFF;
+	regs[1] = on >> 8;
+	regs[2] = off & 0xFF;
+	regs[3] = off >> 8;
+
+	if (value == 0)
+		regs[3] = PCA9685_FULL;
+	else if (value == 0xFF)
+		regs[1] |= PCA9685_FULL;
+}
+
+/*!	@brief Initialise the Dimmer module
+ *
+ *	Sets up the controllers and the TWI bus, blocking until done.
+ *	All outputs stay off until the first dimmerUpdate.
+ *
+ *	@param[in] **outputs	Output Pin definitions (unused)
+ *	@param[in] *values		Channel values
+ *	@param[in] outputCount	Number of channels
+ *	@date 19.10.26			First implementation					*/
+void dimmerInit(pin_t** outputs, uint8_t* values, int outputCount)
+{
+	(void)outputs;
+
+	dimmerOutputsCount = (outputCount > DIMMER_MAX_CHANNELS) ? DIMMER_MAX_CHANNELS : outputCount;
+	dimmerValues = values;
+
+	twiInitMaster(TWI_16M_400K);
+	twiMasterWait();
+
+	for (uint_fast8_t chip = 0; chip < CONF_DIMMER_PCA9685_COUNT; ++chip)
+	{
+		// The prescaler can only be written while sleeping
+		dimmerWriteRegister(chip, PCA9685_REG_MODE1, PCA9685_MODE1_SLEEP);
+		dimmerWriteRegister(chip, PCA9685_REG_PRE_SCALE, CONF_DIMMER_PCA9685_PRESCALE);
+		dimmerWriteRegister(chip, PCA9685_REG_ALL_OFF_H, PCA9685_FULL);
+		dimmerWriteRegister(chip, PCA9685_REG_MODE2, PCA9685_MODE2_OUTDRV);
+		dimmerWriteRegister(chip, PCA9685_REG_MODE1, PCA9685_MODE1_AI);
+		dimmerDirty[chip] = 0xFFFF;
+	}
+
+	dimmerBurstMask = 0;
+}
+
+/*!	@brief Send changed channel values
+ *
+ *	Starts at most one transfer, covering the first run of changed
+ *	channels. Fails while a transfer is in progress, or channels are
+ *	left to be sent; call again later.
+ *
+ *	@return bool			true, if all values have been sent
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Failed transfers by the TWI status		*/
+bool dimmerUpdate(void)
+{
+	if (twiMasterIsBusy())
+		return false;
+
+	// Repeat a failed transfer
+	if (twiMasterHasFailed())
+		dimmerDirty[dimmerBurstChip] |= dimmerBurstMask;
+	dimmerBurstMask = 0;
+
+	for (uint_fast8_t i = 0; i < dimmerOutputsCount; ++i)
+	{
+		if (dimmerValues[i] != dimmerSent[i])
+			dimmerDirty[i / PCA9685_CHANNELS] |= (uint16_t)1 << (i % PCA9685_CHANNELS);
+	}
+
+	for (uint_fast8_t chip = 0; chip < CONF_DIMMER_PCA9685_COUNT; ++chip)
+	{
+		uint16_t dirty = dimmerDirty[chip];
+		if (dirty == 0)
+			continue;
+
+		uint8_t first = 0;
+		while (!(dirty & ((uint16_t)1 << first)))
+			++first;
+
+		uint8_t length = 1;
+		dimmerBuffer[0] = PCA9685_REG_LED0_ON_L + first * PCA9685_LED_REGS;
+		for (uint8_t channel = first; (channel < PCA9685_CHANNELS) && (dirty & ((uint16_t)1 << channel)); ++channel)
+		{
+			uint8_t index = chip * PCA9685_CHANNELS + channel;
+			uint8_t value = (index < dimmerOutputsCount) ? dimmerValues[index] : 0;
+
+			dimmerFillLed(&dimmerBuffer[length], channel, value);
+			length += PCA9685_LED_REGS;
+			if (index < dimmerOutputsCount)
+				dimmerSent[index] = value;
+			dimmerBurstMask |= (uint16_t)1 << channel;
+		}
+
+		dimmerDirty[chip] &= ~dimmerBurstMask;
+		dimmerBurstChip = chip;
+		twiMasterWrite(DIMMER_PCA9685_ADDRESS + chip, dimmerBuffer, length);
+		return false;
+	}
+
+	return true;
+}
+
+#endif /* CONF_DIMMER_USE_PCA9685 */
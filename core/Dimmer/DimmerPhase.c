@@ -0,0 +1,296 @@
+/*!	@brief Dimmer functionality using mains phase-cut (leading edge),
+ *	              firing triacs through pins connected to the MCU.
+ *
+ *	A zero-cross detector at INT0 (PD2) signals the start of every
+ *	mains half-cycle with a rising edge. A channel's triac is fired
+ *	the later into the half-cycle, the lower its value; it then
+ *	conducts until the next zero crossing.
+ *
+ *	dimmerUpdate sorts the channels by firing delay into a schedule,
+ *	merging channels that fire at (almost) the same time into one
+ *	event with one output mask per port. At the zero crossing, the
+ *	INT0 ISR points Timer 1 compare B at the first event, and every
+ *	compare match fires one event and sets up the next one, so all
+ *	channels are served in a single pass through the schedule. An
+ *	event ends the gate pulse of the previous one; a last event ends
+ *	the pulse of the latest channel. Schedules are double buffered and
+ *	swapped at a zero crossing, and only rebuilt when values change.
+ *
+ *	Timer 1 runs free at 4us per tick, shared with the IR receiver.
+ *	Delays are kept as a fraction of the half-cycle, which is measured
+ *	from the zero crossings, so 50Hz and 60Hz mains both work.
+ *
+ *	@author inselc
+ *	@date 19.10.26			First implementation					*/
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#include "../../modules/timer/timer.h"
+#include "Dimmer.h"
+
+#if defined(CONF_DIMMER_USE_PHASE)
+
+#define DIMMER_PORT_NONE		0xFF
+#define DIMMER_PHASE_OFF		0xFF	/* Event phase: end the last gate pulse */
+#define DIMMER_PHASE_MIN_GAP	2		/* Events closer than this are merged, in 1/256 half-cycles */
+#define DIMMER_PHASE_MARGIN		50		/* No firing this close to a zero crossing, in ticks (200us) */
+#define DIMMER_PHASE_PULSE		25		/* Gate pulse of the last event, in ticks (100us) */
+#define DIMMER_PHASE_HALF_MIN	1500	/* Shortest half-cycle accepted, in ticks (6ms) */
+#define DIMMER_PHASE_HALF_MAX	3000	/* Longest half-cycle accepted, in ticks (12ms) */
+#define DIMMER_PHASE_HALF_INIT	2500	/* Half-cycle until measured, 50Hz */
+
+/*!	@brief Firing event, channels firing at the same delay			*/
+typedef struct {
+	uint8_t phase;							//!< Delay, in 1/256 half-cycles
+	uint8_t masks[DIMMER_MAX_PORTS];		//!< Gates to fire, by port
+} dimmerPhaseEvent_t;
+
+static pin_t** dimmerOutputs = NULL;						//!< Array of output pin descriptions
+static uint8_t* dimmerValues;								//!< Corresponding channel values
+static uint8_t dimmerOutputsCount = 0;						//!< Number of channels
+
+static volatile uint8_t* dimmerPorts[DIMMER_MAX_PORTS];		//!< Output registers of the used ports
+static uint8_t dimmerPortMasks[DIMMER_MAX_PORTS];			//!< Output pins, by used port
+static uint8_t dimmerPortCount = 0;							//!< Number of used ports
+static uint8_t dimmerChannelPorts[DIMMER_MAX_CHANNELS];		//!< Port index, by channel
+
+/*!	@brief Firing schedules [buffer][event], sorted by delay		*/
+static dimmerPhaseEvent_t dimmerSchedule[2][DIMMER_MAX_CHANNELS + 1];
+static uint8_t dimmerEventCount[2] = {0, 0};				//!< Events, by buffer
+static volatile uint8_t dimmerFront = 0;					//!< Buffer run by the ISRs
+static volatile bool dimmerPending = false;					//!< Back buffer waits to be run
+
+static uint16_t dimmerZeroCross = 0;						//!< Time of the last zero crossing
+static uint16_t dimmerHalfCycle = DIMMER_PHASE_HALF_INIT;	//!< Measured half-cycle, in ticks
+static uint16_t dimmerSpan = DIMMER_PHASE_HALF_INIT - 2 * DIMMER_PHASE_MARGIN;	//!< Firing window, in ticks
+static uint8_t dimmerEventIndex = 0;						//!< Next event to fire
+static uint16_t dimmerEventTime = 0;						//!< Time of the current event
+
+/*!	@brief Get the firing time of a delay, relative to the zero
+ *	       crossing
+ *
+ *	@param[in] phase		Delay, in 1/256 half-cycles
+ *	@return uint16_t		Delay, in ticks
+ *	@date 19.10.26			First implementation					*/
+static inline uint16_t dimmerPhaseTicks(uint8_t phase)
+{
+	return DIMMER_PHASE_MARGIN + (uint16_t)(((uint32_t)dimmerSpan * phase) >> 8);
+}
+
+/*!	@brief Set the gates of an event, ending the previous pulses
+ *
+ *	@param[in] *event		Firing event
+ *	@date 19.10.26			First implementation					*/
+static inline void dimmerPhaseFire(const dimmerPhaseEvent_t* event)
+{
+	for (uint_fast8_t port = 0; port < dimmerPortCount; ++port)
+	{
+		*dimmerPorts[port] = (*dimmerPorts[port] & ~dimmerPortMasks[port]) | event->masks[port];
+	}
+}
+
+/*!	@brief Initialise the Dimmer module
+ *
+ *	Channels without a pin description (NULL) are skipped.
+ *
+ *	@param[in] **outputs	Output Pin definitions
+ *	@param[in] *values		Channel values
+ *	@param[in] outputCount	Number of channels
+ *	@date 19.10.26			First implementation					*/
+void dimmerInit(pin_t** outputs, uint8_t* values, int outputCount)
+{
+	// Stop firing while the ports are regrouped
+	EIMSK &= ~(1 << INT0);
+	TIMSK1 &= ~(1 << OCIE1B);
+	for (uint_fast8_t port = 0; port < dimmerPortCount; ++port)
+	{
+		*dimmerPorts[port] &= ~dimmerPortMasks[port];
+	}
+
+	// Setup pointers
+	dimmerOutputs = outputs;
+	dimmerOutputsCount = (outputCount > DIMMER_MAX_CHANNELS) ? DIMMER_MAX_CHANNELS : outputCount;
+	dimmerValues = values;
+
+	// Collect the ports used
+	dimmerPortCount = 0;
+	for (uint_fast8_t i = 0; i < dimmerOutputsCount; ++i)
+	{
+		dimmerChannelPorts[i] = DIMMER_PORT_NONE;
+		if (dimmerOutputs[i] == NULL)
+			continue;
+
+		uint8_t port = 0;
+		while ((port < dimmerPortCount) && (dimmerPorts[port] != dimmerOutputs[i]->Port))
+			++port;
+		if (port == dimmerPortCount)
+		{
+			if (dimmerPortCount == DIMMER_MAX_PORTS)
+				continue;
+			dimmerPorts[port] = dimmerOutputs[i]->Port;
+			dimmerPortMasks[port] = 0;
+			++dimmerPortCount;
+		}
+		dimmerPortMasks[port] |= 1 << dimmerOutputs[i]->Number;
+		dimmerChannelPorts[i] = port;
+	}
+
+	// Run the initial values from the next zero crossing on
+	dimmerPending = false;
+	dimmerUpdate();
+	dimmerFront ^= 1;
+	dimmerPending = false;
+
+	// Zero-cross input with pull-up, interrupt on the rising edge
+	DDRD &= ~(1 << PD2);
+	PORTD |= 1 << PD2;
+	EICRA = (EICRA & ~((1 << ISC01) | (1 << ISC00))) | (1 << ISC01) | (1 << ISC00);
+
+	timer1StartFreeRunning();
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		dimmerZeroCross = TCNT1;
+		EIFR = 1 << INTF0;
+		EIMSK |= 1 << INT0;
+	}
+}
+
+/*!	@brief Prepare the firing schedule for changed channel values
+ *
+ *	The new values are used from the next half-cycle on. Fails while
+ *	the previous update has not been used yet; call again later.
+ *
+ *	@return bool			true, if the values were taken
+ *	@date 19.10.26			First implementation					*/
+bool dimmerUpdate(void)
+{
+	if (dimmerPending)
+		return false;
+
+	// Sort the channels to fire by delay
+	uint8_t order[DIMMER_MAX_CHANNELS];
+	uint8_t count = 0;
+	for (uint_fast8_t i = 0; i < dimmerOutputsCount; ++i)
+	{
+		if ((dimmerChannelPorts[i] == DIMMER_PORT_NONE) || (dimmerValues[i] == 0))
+			continue;
+
+		uint8_t pos = count++;
+		while ((pos > 0) && (dimmerValues[order[pos - 1]] < dimmerValues[i]))
+		{
+			order[pos] = order[pos - 1];
+			--pos;
+		}
+		order[pos] = i;
+	}
+
+	// One event per delay, plus the end of the last pulse
+	uint8_t back = dimmerFront ^ 1;
+	dimmerPhaseEvent_t* events = dimmerSchedule[back];
+	uint8_t eventCount = 0;
+	for (uint_fast8_t i = 0; i < count; ++i)
+	{
+		uint8_t channel = order[i];
+		uint8_t phase = 0xFF - dimmerValues[channel];
+
+		if ((eventCount == 0) || (phase - events[eventCount - 1].phase >= DIMMER_PHASE_MIN_GAP))
+		{
+			events[eventCount].phase = phase;
+			memset(events[eventCount].masks, 0, sizeof(events[0].masks));
+			++eventCount;
+		}
+		events[eventCount - 1].masks[dimmerChannelPorts[channel]] |= 1 << dimmerOutputs[channel]->Number;
+	}
+	events[eventCount].phase = DIMMER_PHASE_OFF;
+	memset(events[eventCount].masks, 0, sizeof(events[0].masks));
+	dimmerEventCount[back] = eventCount + 1;
+
+	dimmerPending = true;
+	return true;
+}
+
+// -----------------------------------------------------------------
+
+/*!	@brief External Interrupt 0 ISR: zero crossing
+ *
+ *	@date 19.10.26		First implementation						*/
+ISR(INT0_vect)
+{
+	uint16_t now = TCNT1;
+	uint16_t halfCycle = now - dimmerZeroCross;
+
+	// Noise on the detector
+	if (halfCycle < DIMMER_PHASE_HALF_MIN)
+		return;
+
+	dimmerZeroCross = now;
+
+	// End all gate pulses, the triacs turn off at zero anyway
+	TIMSK1 &= ~(1 << OCIE1B);
+	for (uint_fast8_t port = 0; port < dimmerPortCount; ++port)
+	{
+		*dimmerPorts[port] &= ~dimmerPortMasks[port];
+	}
+
+	// Track the mains frequency, ignoring gaps in the signal
+	if (halfCycle <= DIMMER_PHASE_HALF_MAX)
+	{
+		dimmerHalfCycle = (dimmerHalfCycle * 3 + halfCycle) >> 2;
+		dimmerSpan = dimmerHalfCycle - 2 * DIMMER_PHASE_MARGIN;
+	}
+
+	// Take a new schedule
+	if (dimmerPending)
+	{
+		dimmerFront ^= 1;
+		dimmerPending = false;
+	}
+
+	// Nothing to fire but the end of pulses
+	if (dimmerEventCount[dimmerFront] < 2)
+		return;
+
+	dimmerEventIndex = 0;
+	dimmerEventTime = now + dimmerPhaseTicks(dimmerSchedule[dimmerFront][0].phase);
+	timer1SetCompareB(dimmerEventTime);
+	TIFR1 = 1 << OCF1B;
+	TIMSK1 |= 1 << OCIE1B;
+}
+
+/*!	@brief Timer 1 Compare Match B ISR: fire the next event
+ *
+ *	Events already due are fired right away.
+ *
+ *	@date 19.10.26		First implementation						*/
+ISR(TIMER1_COMPB_vect)
+{
+	const dimmerPhaseEvent_t* events = dimmerSchedule[dimmerFront];
+	uint8_t count = dimmerEventCount[dimmerFront];
+
+	for (;;)
+	{
+		dimmerPhaseFire(&events[dimmerEventIndex]);
+		if (++dimmerEventIndex >= count)
+		{
+			TIMSK1 &= ~(1 << OCIE1B);
+			return;
+		}
+
+		uint8_t phase = events[dimmerEventIndex].phase;
+		dimmerEventTime = (phase == DIMMER_PHASE_OFF) ?
+			dimmerEventTime + DIMMER_PHASE_PULSE :
+			dimmerZeroCross + dimmerPhaseTicks(phase);
+
+		if ((int16_t)(dimmerEventTime - TCNT1) > 1)
+		{
+			timer1SetCompareB(dimmerEventTime);
+			return;
+		}
+	}
+}
+
+#endif /* CONF_DIMMER_USE_PHASE */
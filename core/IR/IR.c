@@ -0,0 +1,352 @@
+/*!	@brief Infrared remote receiver
+ *
+ *	Timer 1 runs free at 4us per tick. The input capture unit latches
+ *	the timer at every edge of ICP1 (PB0), so the measured pulse and
+ *	space lengths do not depend on interrupt latency, and decoding
+ *	never has to wait for the line. The capture ISR takes the time
+ *	since the previous edge, swaps the capture edge, and feeds the
+ *	length to both decoders, which reject the frame as soon as a
+ *	length does not fit their protocol.
+ *
+ *	Compare A of Timer 1 is set 12ms past the last edge. When it
+ *	fires, the line has been idle for longer than any valid pulse or
+ *	space, and the decoders are reset for the next frame. Compare B is
+ *	left to the phase dimmer, which shares the time base.
+ *
+ *	NEC: 9ms leader mark, 4.5ms space, 32 bits LSB first, each a
+ *	562us mark followed by a 562us (0) or 1687us (1) space. A held
+ *	key sends a 9ms mark and a 2.25ms space every 108ms.
+ *
+ *	RC5: 14 Manchester coded bits of 1778us, a 1 being a space
+ *	followed by a mark. The first half of the first start bit is
+ *	never seen as an edge. A held key resends the frame with the same
+ *	toggle bit.
+ *
+ *	@author inselc
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Shared Timer 1 time base				*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#include "../../modules/timer/timer.h"
+#include "../Clock/Clock.h"
+#include "IR.h"
+
+#if (IR_QUEUE_SIZE & (IR_QUEUE_SIZE - 1)) || (IR_QUEUE_SIZE > 128)
+#error "IR_QUEUE_SIZE must be a power of two, up to 128"
+#endif
+
+#define IR_QUEUE_MASK		(IR_QUEUE_SIZE - 1)
+#define IR_TICK_US			4						/* Timer 1 tick at F_CPU / 64 */
+#define IR_TICKS(us)		((uint16_t)((us) / IR_TICK_US))
+#define IR_TIMEOUT			IR_TICKS(12000UL)		/* Idle time that ends a frame */
+
+/*!	@brief Check a length against a nominal length, +-25%			*/
+#define IR_MATCH(ticks, us)	(((ticks) >= IR_TICKS((us) * 3UL / 4)) && ((ticks) <= IR_TICKS((us) * 5UL / 4)))
+
+#define IR_NEC_LEADER_MARK_US		9000
+#define IR_NEC_LEADER_SPACE_US		4500
+#define IR_NEC_REPEAT_SPACE_US		2250
+#define IR_NEC_BIT_MARK_US			562
+#define IR_NEC_ZERO_SPACE_US		562
+#define IR_NEC_ONE_SPACE_US			1687
+#define IR_NEC_BITS					32
+
+#define IR_RC5_HALF_BIT_US			889
+#define IR_RC5_HALF_BITS			27		/* Half bits needed to know all 14 bits */
+#define IR_RC5_FAILED				0xFF
+
+/*!	@enum irNecState_t
+ *	@brief NEC decoder states, by the next expected length			*/
+typedef enum {
+	IR_NEC_LEADER_MARK,
+	IR_NEC_LEADER_SPACE,
+	IR_NEC_BIT_MARK,
+	IR_NEC_BIT_SPACE,
+	IR_NEC_DONE					//!< Frame decoded or rejected
+} irNecState_t;
+
+static irCode_t irQueue[IR_QUEUE_SIZE];
+static volatile uint8_t irQueueHead = 0;		//!< Write index (free-running)
+static volatile uint8_t irQueueTail = 0;		//!< Read index (free-running)
+static volatile uint8_t irQueueOverflows = 0;	//!< Codes lost to a full queue
+
+static bool irActive = false;			//!< Frame in progress
+static uint16_t irLastEdge;				//!< Capture time of the previous edge
+
+static uint8_t irNecState = IR_NEC_DONE;
+static uint8_t irNecBits;				//!< Bits received
+static uint32_t irNecData;				//!< Bits received, LSB first
+
+static uint8_t irRc5HalfBits = IR_RC5_FAILED;	//!< Half bits received
+static bool irRc5FirstHalf;				//!< Level of the current bit's first half
+static uint16_t irRc5Data;				//!< Bits received, MSB first
+
+static irCode_t irLastCode;				//!< Last code, for repeats
+static uint16_t irLastCodeTime;			//!< Time of the last frame
+static uint8_t irRc5Toggle = 0xFF;		//!< Toggle bit of the last RC5 frame
+
+/*!	@brief Initialise the infrared receiver
+ *
+ *	Starts Timer 1 free-running, unless already running, and enables
+ *	the capture interrupt.
+ *
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Share Timer 1 with the phase dimmer		*/
+void irInit(void)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		// ICP1 input with pull-up, receiver output idles high
+		DDRB &= ~(1 << PB0);
+		PORTB |= 1 << PB0;
+
+		timer1StartFreeRunning();
+		timer1SetCapture(TMR1_CAPTURE_FALLING, true);
+
+		irActive = false;
+		irNecState = IR_NEC_DONE;
+		irRc5HalfBits = IR_RC5_FAILED;
+		irLastCode.protocol = IR_PROTOCOL_NONE;
+
+		irQueueHead = 0;
+		irQueueTail = 0;
+		irQueueOverflows = 0;
+
+		TIFR1 = 1 << ICF1;
+		TIMSK1 |= 1 << ICIE1;
+	}
+}
+
+/*!	@brief Take the oldest key code from the queue
+ *
+ *	@param[out] *code		Key code buffer
+ *	@return bool			true, if a key code was read
+ *	@date 19.10.26			First implementation					*/
+bool irGetCode(irCode_t* code)
+{
+	uint8_t tail = irQueueTail;
+
+	if (code == NULL || irQueueHead == tail)
+		return false;
+
+	*code = irQueue[tail & IR_QUEUE_MASK];
+	irQueueTail = tail + 1;
+	return true;
+}
+
+/*!	@brief Get number of key codes lost to a full queue
+ *
+ *	@return uint8_t			Overflow count (saturating)
+ *	@date 19.10.26			First implementation					*/
+uint8_t irGetOverflowCount(void)
+{
+	return irQueueOverflows;
+}
+
+// -----------------------------------------------------------------
+
+/*!	@brief Queue a decoded key code
+ *
+ *	A frame is a repeat if it matches the previous one, and follows
+ *	it within IR_REPEAT_TIMEOUT_MS.
+ *
+ *	@param[in] protocol		Protocol
+ *	@param[in] address		Device address
+ *	@param[in] command		Key code
+ *	@param[in] repeat		Frame repeats the previous one, if recent
+ *	@date 19.10.26			First implementation					*/
+static void irQueueCode(irProtocol_t protocol, uint16_t address, uint8_t command, bool repeat)
+{
+	uint16_t now = (uint16_t)clockMilliseconds;
+
+	repeat = repeat && ((uint16_t)(now - irLastCodeTime) <= IR_REPEAT_TIMEOUT_MS) &&
+		(irLastCode.protocol == protocol) && (irLastCode.address == address) &&
+		(irLastCode.command == command);
+	irLastCode.protocol = protocol;
+	irLastCode.address = address;
+	irLastCode.command = command;
+	irLastCode.repeat = repeat;
+	irLastCodeTime = now;
+
+	uint8_t head = irQueueHead;
+	if ((uint8_t)(head - irQueueTail) < IR_QUEUE_SIZE)
+	{
+		irQueue[head & IR_QUEUE_MASK] = irLastCode;
+		irQueueHead = head + 1;
+	}
+	else if (irQueueOverflows < UINT8_MAX)
+	{
+		++irQueueOverflows;
+	}
+}
+
+/*!	@brief Feed a mark or space length to the NEC decoder
+ *
+ *	@param[in] ticks		Length in timer ticks
+ *	@date 19.10.26			First implementation					*/
+static inline void irDecodeNec(uint16_t ticks)
+{
+	switch (irNecState)
+	{
+		case IR_NEC_LEADER_MARK:
+			irNecState = IR_MATCH(ticks, IR_NEC_LEADER_MARK_US) ? IR_NEC_LEADER_SPACE : IR_NEC_DONE;
+			break;
+
+		case IR_NEC_LEADER_SPACE:
+			irNecState = IR_NEC_DONE;
+			if (IR_MATCH(ticks, IR_NEC_LEADER_SPACE_US))
+			{
+				irNecBits = 0;
+				irNecData = 0;
+				irNecState = IR_NEC_BIT_MARK;
+			}
+			else if (IR_MATCH(ticks, IR_NEC_REPEAT_SPACE_US) && (irLastCode.protocol == IR_PROTOCOL_NEC))
+			{
+				irQueueCode(IR_PROTOCOL_NEC, irLastCode.address, irLastCode.command, true);
+			}
+			break;
+
+		case IR_NEC_BIT_MARK:
+			irNecState = IR_MATCH(ticks, IR_NEC_BIT_MARK_US) ? IR_NEC_BIT_SPACE : IR_NEC_DONE;
+			break;
+
+		case IR_NEC_BIT_SPACE:
+			irNecData >>= 1;
+			if (IR_MATCH(ticks, IR_NEC_ONE_SPACE_US))
+			{
+				irNecData |= 0x80000000UL;
+			}
+			else if (!IR_MATCH(ticks, IR_NEC_ZERO_SPACE_US))
+			{
+				irNecState = IR_NEC_DONE;
+				break;
+			}
+
+			irNecState = IR_NEC_BIT_MARK;
+			if (++irNecBits == IR_NEC_BITS)
+			{
+				uint8_t address = irNecData;
+				uint8_t addressHigh = irNecData >> 8;
+				uint8_t command = irNecData >> 16;
+				uint8_t commandInverted = irNecData >> 24;
+
+				irNecState = IR_NEC_DONE;
+				if ((uint8_t)(command ^ commandInverted) != 0xFF)
+					break;
+
+				// Standard NEC repeats the address inverted, extended NEC uses 16 bits
+				irQueueCode(IR_PROTOCOL_NEC,
+					((uint8_t)~address == addressHigh) ? address : (((uint16_t)addressHigh << 8) | address),
+					command, false);
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+/*!	@brief Feed a mark or space length to the RC5 decoder
+ *
+ *	@param[in] mark			Length of a mark (receiver output low)
+ *	@param[in] ticks		Length in timer ticks
+ *	@date 19.10.26			First implementation					*/
+static inline void irDecodeRc5(bool mark, uint16_t ticks)
+{
+	if (irRc5HalfBits == IR_RC5_FAILED)
+		return;
+
+	uint8_t halfBits;
+	if (IR_MATCH(ticks, IR_RC5_HALF_BIT_US))
+		halfBits = 1;
+	else if (IR_MATCH(ticks, 2 * IR_RC5_HALF_BIT_US))
+		halfBits = 2;
+	else
+	{
+		irRc5HalfBits = IR_RC5_FAILED;
+		return;
+	}
+
+	while (halfBits--)
+	{
+		if ((irRc5HalfBits & 0x01) == 0)
+		{
+			// First half: a space starts a 1
+			irRc5FirstHalf = mark;
+			irRc5Data = (irRc5Data << 1) | (mark ? 0 : 1);
+		}
+		else if (irRc5FirstHalf == mark)
+		{
+			// No transition in the middle of the bit
+			irRc5HalfBits = IR_RC5_FAILED;
+			return;
+		}
+		++irRc5HalfBits;
+	}
+
+	if (irRc5HalfBits >= IR_RC5_HALF_BITS)
+	{
+		irRc5HalfBits = IR_RC5_FAILED;
+
+		// S1, S2 (inverted command bit 6), toggle, 5 address bits, 6 command bits
+		uint8_t toggle = (irRc5Data >> 11) & 0x01;
+		uint8_t command = (irRc5Data & 0x3F) | ((irRc5Data & (1 << 12)) ? 0 : 0x40);
+		irQueueCode(IR_PROTOCOL_RC5, (irRc5Data >> 6) & 0x1F, command, toggle == irRc5Toggle);
+		irRc5Toggle = toggle;
+	}
+}
+
+/*!	@brief Timer 1 Capture ISR
+ *
+ *	@date 19.10.26			First implementation					*/
+ISR(TIMER1_CAPT_vect)
+{
+	uint16_t now = ICR1;
+	bool mark = (TCCR1B & (1 << ICES1)) != 0;	// Rising edge ends a mark
+	uint16_t ticks = now - irLastEdge;
+
+	irLastEdge = now;
+	timer1ToggleCaptureEdge();
+
+	// Idle timeout
+	timer1SetCompareA(now + IR_TIMEOUT);
+	TIFR1 = 1 << OCF1A;
+	TIMSK1 |= 1 << OCIE1A;
+
+	if (!irActive)
+	{
+		// First mark of a frame, the length before it is the idle time
+		irActive = true;
+		irNecState = IR_NEC_LEADER_MARK;
+		irRc5HalfBits = 1;
+		irRc5FirstHalf = false;
+		irRc5Data = 1;
+		return;
+	}
+
+	irDecodeNec(ticks);
+	irDecodeRc5(mark, ticks);
+}
+
+/*!	@brief Timer 1 Compare A ISR
+ *
+ *	The line has been idle for IR_TIMEOUT, the frame is over.
+ *
+ *	@date 19.10.26			First implementation					*/
+ISR(TIMER1_COMPA_vect)
+{
+	TIMSK1 &= ~(1 << OCIE1A);
+
+	irActive = false;
+	irNecState = IR_NEC_DONE;
+	irRc5HalfBits = IR_RC5_FAILED;
+
+	// Wait for the next frame's first mark
+	timer1SetCapture(TMR1_CAPTURE_FALLING, true);
+	TIFR1 = 1 << ICF1;
+}
@@ -0,0 +1,51 @@
+/*!	@brief Infrared remote receiver
+ *
+ *	Decodes NEC and RC5 frames from a demodulating IR receiver
+ *	(TSOP type, active low) at ICP1. Every edge is timestamped by the
+ *	Timer 1 input capture unit, and the ISR decodes the frame from the
+ *	time between edges. Decoded key codes are queued for the main loop.
+ *
+ *	@author inselc
+ *	@date 19.10.26			First implementation					*/
+
+#ifndef IR_H_
+#define IR_H_
+
+/*!	@file */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define IR_QUEUE_SIZE			4		/* Key code queue size, power of two */
+#define IR_REPEAT_TIMEOUT_MS	150		/* Longest gap between frames of a held key */
+
+/*!	@enum irProtocol_t
+ *	@brief Remote control protocols									*/
+typedef enum {
+	IR_PROTOCOL_NONE = 0,
+	IR_PROTOCOL_NEC = 1,	//!< NEC and extended NEC, 16 bit address
+	IR_PROTOCOL_RC5 = 2		//!< Philips RC5 and RC5x, 7 bit command
+} irProtocol_t;
+
+/*!	@struct irCode_t
+ *	@brief Decoded key code
+ *	@var irCode_t::protocol
+ *	Protocol of the frame (irProtocol_t)
+ *	@var irCode_t::address
+ *	Device address
+ *	@var irCode_t::command
+ *	Key code
+ *	@var irCode_t::repeat
+ *	Key is held, the frame repeats the previous one					*/
+typedef struct {
+	uint8_t protocol;
+	uint16_t address;
+	uint8_t command;
+	bool repeat;
+} irCode_t;
+
+void irInit(void);
+bool irGetCode(irCode_t* code);
+uint8_t irGetOverflowCount(void);
+
+#endif /* IR_H_ */
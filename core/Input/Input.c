@@ -0,0 +1,527 @@
+/*!	@brief Interrupt-driven digital inputs
+ *
+ *	All enabled pins of a port are debounced together by a 2-bit
+ *	vertical counter: one counter bit per pin in each of two bytes,
+ *	so a whole port takes a handful of bitwise operations per sample.
+ *	A pin has to read the same level for four consecutive samples
+ *	before its debounced state changes.
+ *
+ *	Sampling runs on the Timer 2 Compare B interrupt, which fires
+ *	once per millisecond alongside the system clock. A pin change
+ *	interrupt only marks its port active and notes the time of the
+ *	edge; the sampling interrupt is switched off again once every
+ *	active port has settled, so idle inputs cost nothing.
+ *
+ *	Quadrature encoder pins are not debounced. The pin change
+ *	interrupt decodes them directly with a state table lookup, which
+ *	rejects contact bounce by itself: a bouncing contact only steps
+ *	back and forth between two neighbouring states.
+ *
+ *	@author inselc
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Vertical counter debouncing
+ *	@date 19.10.26			Pin descriptions from port and number
+ *	@date 19.10.26			Quadrature encoders						*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#include <avr/pgmspace.h>
+#include "../../modules/timer/timer.h"
+#include "../Clock/Clock.h"
+#include "Input.h"
+
+#if (INPUT_QUEUE_SIZE & (INPUT_QUEUE_SIZE - 1)) || (INPUT_QUEUE_SIZE > 128)
+#error "INPUT_QUEUE_SIZE must be a power of two, up to 128"
+#endif
+
+#define INPUT_QUEUE_MASK	(INPUT_QUEUE_SIZE - 1)
+#define INPUT_TICK_COMPARE	124		/* Sample half-way between clock ticks */
+
+/*	Compiler memory barrier: keeps the event copy ahead of the tail
+	update, which hands the slot back to the interrupt				*/
+#define INPUT_BARRIER()		__asm__ __volatile__ ("" ::: "memory")
+
+static inputEvent_t inputQueue[INPUT_QUEUE_SIZE];
+static volatile uint8_t inputQueueHead = 0;			//!< Write index (free-running)
+static volatile uint8_t inputQueueTail = 0;			//!< Read index (free-running)
+static volatile uint8_t inputQueueOverflows = 0;	//!< Events lost to a full queue
+
+static volatile uint8_t inputState[INPUT_PORT_COUNT];	//!< Debounced port states
+static uint8_t inputCount0[INPUT_PORT_COUNT];			//!< Vertical counter, bit 0
+static uint8_t inputCount1[INPUT_PORT_COUNT];			//!< Vertical counter, bit 1
+static uint16_t inputEdgeTime[INPUT_PORT_COUNT];		//!< Time of the first raw edge
+static volatile uint8_t inputActivePorts = 0;			//!< Ports being debounced
+static uint8_t inputEdgePending = 0;					//!< Ports with a valid edge time
+static uint8_t inputTickDivider = 0;
+static uint8_t inputDebounceMask[INPUT_PORT_COUNT];		//!< Pins to debounce, by port
+
+/*!	@struct inputEncoder_t
+ *	@brief Quadrature encoder decoder state
+ *	@var inputEncoder_t::port
+ *	Port of both encoder pins, INPUT_PORT_NONE if unused
+ *	@var inputEncoder_t::maskA
+ *	Bit mask of pin A
+ *	@var inputEncoder_t::maskB
+ *	Bit mask of pin B
+ *	@var inputEncoder_t::state
+ *	Last pin state (A << 1 | B)
+ *	@var inputEncoder_t::steps
+ *	Accumulated quadrature steps									*/
+typedef struct {
+	uint8_t port;
+	uint8_t maskA;
+	uint8_t maskB;
+	uint8_t state;
+	volatile int16_t steps;
+} inputEncoder_t;
+
+static inputEncoder_t inputEncoders[INPUT_MAX_ENCODERS];
+
+/*!	@brief Quadrature step by (previous state << 2 | new state);
+ *	       invalid transitions (both pins changed) count as 0		*/
+static const int8_t inputEncoderSteps[16] PROGMEM = {
+	 0, -1,  1,  0,
+	 1,  0,  0, -1,
+	-1,  0,  0,  1,
+	 0,  1, -1,  0
+};
+
+/*!	@brief Pin change mask registers, by port						*/
+static volatile uint8_t* const inputPinChangeMasks[INPUT_PORT_COUNT] = {
+	&PCMSK0,
+	&PCMSK1,
+	&PCMSK2
+};
+
+/*!	@brief Port input registers, by port							*/
+static volatile uint8_t* const inputPortRegisters[INPUT_PORT_COUNT] = {
+	&PINB,
+	&PINC,
+	&PIND
+};
+
+/*!	@brief Port output registers, by port							*/
+static volatile uint8_t* const inputPortOutputs[INPUT_PORT_COUNT] = {
+	&PORTB,
+	&PORTC,
+	&PORTD
+};
+
+/*!	@brief Port direction registers, by port						*/
+static volatile uint8_t* const inputPortDirections[INPUT_PORT_COUNT] = {
+	&DDRB,
+	&DDRC,
+	&DDRD
+};
+
+/*!	@brief Enable the pin change interrupts a port's users need
+ *
+ *	@note To be called with interrupts disabled.
+ *
+ *	@param[in] port			Port index
+ *	@date 19.10.26			First implementation					*/
+static void inputUpdatePinChangeMask(uint8_t port)
+{
+	uint8_t mask = inputDebounceMask[port];
+	for (uint8_t i = 0; i < INPUT_MAX_ENCODERS; ++i)
+	{
+		if (inputEncoders[i].port == port)
+			mask |= inputEncoders[i].maskA | inputEncoders[i].maskB;
+	}
+
+	*inputPinChangeMasks[port] = mask;
+	if (mask != 0)
+		PCICR |= 1 << port;
+	else
+		PCICR &= ~(1 << port);
+}
+
+/*!	@brief Initialise the input module
+ *
+ *	Disables all pin change interrupts and clears the event queue.
+ *
+ *	@note Timer 2 has to be running (see clockInit).
+ *
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Debounce tick on Timer 2 Compare B		*/
+void inputInit(void)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		PCICR = 0;
+		TIMSK2 &= ~(1 << OCIE2B);
+		for (uint8_t port = 0; port < INPUT_PORT_COUNT; ++port)
+		{
+			*inputPinChangeMasks[port] = 0;
+			inputDebounceMask[port] = 0;
+			inputState[port] = *inputPortRegisters[port];
+			inputCount0[port] = 0;
+			inputCount1[port] = 0;
+		}
+		PCIFR = (1 << PCIF0) | (1 << PCIF1) | (1 << PCIF2);
+		inputActivePorts = 0;
+		inputEdgePending = 0;
+		for (uint8_t i = 0; i < INPUT_MAX_ENCODERS; ++i)
+		{
+			inputEncoders[i].port = INPUT_PORT_NONE;
+		}
+
+		inputQueueHead = 0;
+		inputQueueTail = 0;
+		inputQueueOverflows = 0;
+
+		timer2SetCompareB(INPUT_TICK_COMPARE);
+	}
+}
+
+/*!	@brief Fill in an input pin description
+ *
+ *	@param[out] *pin		Pin description
+ *	@param[in] port			Input port
+ *	@param[in] number		Pin number at the port (0..7)
+ *	@param[in] pullUp		Enable the internal pull-up
+ *	@return bool			false, if port or number are invalid
+ *	@date 19.10.26			First implementation					*/
+bool inputMakePin(pin_t* pin, inputPort_t port, uint8_t number, bool pullUp)
+{
+	if (pin == NULL || port >= INPUT_PORT_COUNT || number > 7)
+		return false;
+
+	pin->Port = inputPortOutputs[port];
+	pin->DDR = inputPortDirections[port];
+	pin->PINR = inputPortRegisters[port];
+	pin->Number = number;
+	pin->Direction = INPUT;
+	pin->PullUp = pullUp;
+	return true;
+}
+
+/*!	@brief Debounce an input pin and report its edges
+ *
+ *	@param[in] *pin			Input pin
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Start from the current pin state		*/
+void inputEnablePin(pin_t* pin)
+{
+	inputPort_t port = inputGetPort(pin);
+	if (port == INPUT_PORT_NONE)
+		return;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		// Take over the current pin state without reporting an edge
+		uint8_t mask = 1 << pin->Number;
+		inputState[port] = (inputState[port] & ~mask) | (*inputPortRegisters[port] & mask);
+		inputCount0[port] &= ~mask;
+		inputCount1[port] &= ~mask;
+
+		inputDebounceMask[port] |= mask;
+		*inputPinChangeMasks[port] |= mask;
+		PCICR |= 1 << port;
+	}
+}
+
+/*!	@brief Stop debouncing an input pin
+ *
+ *	@param[in] *pin			Input pin
+ *	@date 19.10.26			First implementation					*/
+void inputDisablePin(pin_t* pin)
+{
+	inputPort_t port = inputGetPort(pin);
+	if (port == INPUT_PORT_NONE)
+		return;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		inputDebounceMask[port] &= ~(1 << pin->Number);
+		inputUpdatePinChangeMask(port);
+	}
+}
+
+/*!	@brief Decode a quadrature encoder
+ *
+ *	Both pins have to be on the same port.
+ *
+ *	@param[in] encoder		Encoder index
+ *	@param[in] *pinA		Encoder pin A
+ *	@param[in] *pinB		Encoder pin B
+ *	@return bool			false, if the arguments are invalid
+ *	@date 19.10.26			First implementation					*/
+bool inputEnableEncoder(uint8_t encoder, pin_t* pinA, pin_t* pinB)
+{
+	inputPort_t port = inputGetPort(pinA);
+	if (encoder >= INPUT_MAX_ENCODERS || port == INPUT_PORT_NONE || inputGetPort(pinB) != port || pinA->Number == pinB->Number)
+		return false;
+
+	inputDisableEncoder(encoder);
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		inputEncoder_t* enc = &inputEncoders[encoder];
+		uint8_t state = *inputPortRegisters[port];
+		enc->maskA = 1 << pinA->Number;
+		enc->maskB = 1 << pinB->Number;
+		enc->state = ((state & enc->maskA) ? 0x02 : 0x00) | ((state & enc->maskB) ? 0x01 : 0x00);
+		enc->steps = 0;
+		enc->port = port;
+
+		inputUpdatePinChangeMask(port);
+	}
+	return true;
+}
+
+/*!	@brief Stop decoding a quadrature encoder
+ *
+ *	@param[in] encoder		Encoder index
+ *	@date 19.10.26			First implementation					*/
+void inputDisableEncoder(uint8_t encoder)
+{
+	if (encoder >= INPUT_MAX_ENCODERS)
+		return;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		uint8_t port = inputEncoders[encoder].port;
+		inputEncoders[encoder].port = INPUT_PORT_NONE;
+		if (port < INPUT_PORT_COUNT)
+			inputUpdatePinChangeMask(port);
+	}
+}
+
+/*!	@brief Take the detents an encoder has moved since the last call
+ *
+ *	Steps not yet making up a full detent are kept.
+ *
+ *	@param[in] encoder		Encoder index
+ *	@return int8_t			Detents, positive clockwise (A leads B)
+ *	@date 19.10.26			First implementation					*/
+int8_t inputGetEncoderDetents(uint8_t encoder)
+{
+	int16_t detents = 0;
+
+	if (encoder >= INPUT_MAX_ENCODERS)
+		return 0;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		detents = inputEncoders[encoder].steps / INPUT_ENCODER_STEPS_PER_DETENT;
+		if (detents > INT8_MAX)
+			detents = INT8_MAX;
+		else if (detents < INT8_MIN)
+			detents = INT8_MIN;
+		inputEncoders[encoder].steps -= detents * INPUT_ENCODER_STEPS_PER_DETENT;
+	}
+	return (int8_t)detents;
+}
+
+/*!	@brief Get the debounced state of a port
+ *
+ *	Only the bits of enabled pins are meaningful.
+ *
+ *	@param[in] port			Input port
+ *	@return uint8_t			Debounced port state
+ *	@date 19.10.26			First implementation					*/
+uint8_t inputGetState(inputPort_t port)
+{
+	if (port >= INPUT_PORT_COUNT)
+		return 0;
+
+	return inputState[port];
+}
+
+/*!	@brief Get the debounced state of an enabled pin
+ *
+ *	@param[in] *pin			Input pin
+ *	@return bool			Debounced pin state
+ *	@date 19.10.26			First implementation					*/
+bool inputReadPin(pin_t* pin)
+{
+	return (inputGetState(inputGetPort(pin)) & (1 << pin->Number)) != 0;
+}
+
+/*!	@brief Check for queued edge events
+ *
+ *	@return bool			true, if an event is available
+ *	@date 19.10.26			First implementation					*/
+bool inputAvailable(void)
+{
+	return inputQueueHead != inputQueueTail;
+}
+
+/*!	@brief Take the oldest event from the queue
+ *
+ *	@param[out] *event		Event buffer
+ *	@return bool			true, if an event was read
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Barrier before releasing the event		*/
+bool inputGetEvent(inputEvent_t* event)
+{
+	uint8_t tail = inputQueueTail;
+
+	if (event == NULL || inputQueueHead == tail)
+		return false;
+
+	*event = inputQueue[tail & INPUT_QUEUE_MASK];
+	INPUT_BARRIER();
+	inputQueueTail = tail + 1;
+	return true;
+}
+
+/*!	@brief Get number of events lost to a full queue
+ *
+ *	@return uint8_t			Overflow count (saturating)
+ *	@date 19.10.26			First implementation					*/
+uint8_t inputGetOverflowCount(void)
+{
+	return inputQueueOverflows;
+}
+
+// -----------------------------------------------------------------
+
+/*!	@brief Queue a debounced edge event
+ *
+ *	@param[in] port			Port index
+ *	@param[in] changed		Pins that changed
+ *	@date 19.10.26			First implementation					*/
+static inline void inputQueueEvent(inputPort_t port, uint8_t changed)
+{
+	uint8_t head = inputQueueHead;
+	if ((uint8_t)(head - inputQueueTail) < INPUT_QUEUE_SIZE)
+	{
+		inputEvent_t* event = &inputQueue[head & INPUT_QUEUE_MASK];
+		event->port = port;
+		event->changed = changed;
+		event->state = inputState[port];
+		event->timestamp = inputEdgeTime[port];
+		inputQueueHead = head + 1;
+	}
+	else if (inputQueueOverflows < UINT8_MAX)
+	{
+		++inputQueueOverflows;
+	}
+}
+
+/*!	@brief Take one debounce sample of a port
+ *
+ *	@param[in] port			Port index
+ *	@date 19.10.26			First implementation					*/
+static inline void inputDebounce(inputPort_t port)
+{
+	uint8_t mask = inputDebounceMask[port];
+	uint8_t sample = *inputPortRegisters[port];
+	uint8_t state = inputState[port];
+
+	// Count pins differing from their debounced state, reset others
+	uint8_t delta = (sample ^ state) & mask;
+	inputCount1[port] = (inputCount1[port] ^ inputCount0[port]) & delta;
+	inputCount0[port] = ~inputCount0[port] & delta;
+
+	// Pins whose counter wrapped around have been stable long enough
+	uint8_t toggle = delta & ~(inputCount0[port] | inputCount1[port]);
+	if (toggle != 0)
+	{
+		inputState[port] = state ^ toggle;
+		inputQueueEvent(port, toggle);
+		inputEdgePending &= ~(1 << port);
+	}
+
+	// Port has settled, all counters are zero
+	if (((sample ^ inputState[port]) & mask) == 0)
+	{
+		inputActivePorts &= ~(1 << port);
+		inputEdgePending &= ~(1 << port);
+	}
+}
+
+/*!	@brief Mark a port for debouncing
+ *
+ *	@param[in] port			Port index
+ *	@date 19.10.26			First implementation					*/
+static inline void inputWake(inputPort_t port)
+{
+	if ((inputEdgePending & (1 << port)) == 0)
+	{
+		inputEdgeTime[port] = (uint16_t)clockMilliseconds;
+		inputEdgePending |= 1 << port;
+	}
+	inputActivePorts |= 1 << port;
+	TIMSK2 |= 1 << OCIE2B;
+}
+
+/*!	@brief Handle a pin change on a port
+ *
+ *	Steps the encoders on the port, and starts debouncing if a
+ *	debounced pin differs from its stable state.
+ *
+ *	@param[in] port			Port index
+ *	@date 19.10.26			First implementation					*/
+static inline void inputPinChange(inputPort_t port)
+{
+	uint8_t state = *inputPortRegisters[port];
+
+	for (uint8_t i = 0; i < INPUT_MAX_ENCODERS; ++i)
+	{
+		inputEncoder_t* enc = &inputEncoders[i];
+		if (enc->port != port)
+			continue;
+
+		uint8_t encoderState = ((state & enc->maskA) ? 0x02 : 0x00) | ((state & enc->maskB) ? 0x01 : 0x00);
+		enc->steps += (int8_t)pgm_read_byte(&inputEncoderSteps[(enc->state << 2) | encoderState]);
+		enc->state = encoderState;
+	}
+
+	if ((state ^ inputState[port]) & inputDebounceMask[port])
+		inputWake(port);
+}
+
+/*!	@brief Timer 2 Compare Match B ISR: debounce sampling
+ *
+ *	@date 19.10.26			First implementation					*/
+ISR(TIMER2_COMPB_vect)
+{
+	if (++inputTickDivider < INPUT_DEBOUNCE_MS)
+		return;
+	inputTickDivider = 0;
+
+	for (uint8_t port = 0; port < INPUT_PORT_COUNT; ++port)
+	{
+		if (inputActivePorts & (1 << port))
+			inputDebounce(port);
+	}
+
+	// Stop sampling while all inputs are idle
+	if (inputActivePorts == 0)
+	{
+		TIMSK2 &= ~(1 << OCIE2B);
+	}
+}
+
+/*!	@brief Pin Change Interrupt 0 ISR: PORTB
+ *
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Encoder decoding						*/
+ISR(PCINT0_vect)
+{
+	inputPinChange(INPUT_PORT_B);
+}
+
+/*!	@brief Pin Change Interrupt 1 ISR: PORTC
+ *
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Encoder decoding						*/
+ISR(PCINT1_vect)
+{
+	inputPinChange(INPUT_PORT_C);
+}
+
+/*!	@brief Pin Change Interrupt 2 ISR: PORTD
+ *
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Encoder decoding						*/
+ISR(PCINT2_vect)
+{
+	inputPinChange(INPUT_PORT_D);
+}
@@ -0,0 +1,88 @@
+/*!	@brief Interrupt-driven digital inputs
+ *
+ *	Enabled pins are debounced in the background, and every
+ *	debounced edge is queued together with a millisecond timestamp.
+ *	The main loop evaluates the queued events when it finds the
+ *	time, so presses are not lost while it is busy.
+ *
+ *	@author inselc
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Vertical counter debouncing
+ *	@date 19.10.26			Pin descriptions from port and number
+ *	@date 19.10.26			Quadrature encoders						*/
+
+#ifndef INPUT_H_
+#define INPUT_H_
+
+/*!	@file */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <avr/io.h>
+#include "../../modules/io/io.h"
+
+#define INPUT_QUEUE_SIZE	16		/* Edge event queue size, power of two */
+#define INPUT_DEBOUNCE_MS	4		/* Sample interval; edges need 4 stable samples */
+#define INPUT_MAX_ENCODERS	2		/* Number of quadrature encoders */
+#define INPUT_ENCODER_STEPS_PER_DETENT	4	/* Quadrature steps per encoder detent */
+
+/*!	@enum inputPort_t
+ *	@brief Input ports, in pin change interrupt order				*/
+typedef enum {
+	INPUT_PORT_B = 0,		//!< PORTB, PCINT0..7
+	INPUT_PORT_C = 1,		//!< PORTC, PCINT8..14
+	INPUT_PORT_D = 2,		//!< PORTD, PCINT16..23
+	INPUT_PORT_COUNT,
+	INPUT_PORT_NONE = 0xFF	//!< Pin is not on a supported port
+} inputPort_t;
+
+/*!	@struct inputEvent_t
+ *	@brief Pin change event
+ *	@var inputEvent_t::port
+ *	Port the edges occurred on (inputPort_t)
+ *	@var inputEvent_t::changed
+ *	Bit mask of the pins that changed (debounced)
+ *	@var inputEvent_t::state
+ *	Debounced port state after the change
+ *	@var inputEvent_t::timestamp
+ *	Lower 16 bits of the system clock at the first raw edge			*/
+typedef struct {
+	uint8_t port;
+	uint8_t changed;
+	uint8_t state;
+	uint16_t timestamp;
+} inputEvent_t;
+
+void inputInit(void);
+bool inputMakePin(pin_t* pin, inputPort_t port, uint8_t number, bool pullUp);
+void inputEnablePin(pin_t* pin);
+void inputDisablePin(pin_t* pin);
+uint8_t inputGetState(inputPort_t port);
+bool inputReadPin(pin_t* pin);
+bool inputEnableEncoder(uint8_t encoder, pin_t* pinA, pin_t* pinB);
+void inputDisableEncoder(uint8_t encoder);
+int8_t inputGetEncoderDetents(uint8_t encoder);
+bool inputAvailable(void);
+bool inputGetEvent(inputEvent_t* event);
+uint8_t inputGetOverflowCount(void);
+
+/*!	@brief Get the input port of a pin
+ *
+ *	@param[in] *pin			Pin description
+ *	@return inputPort_t		Port, or INPUT_PORT_NONE
+ *	@date 19.10.26			First implementation					*/
+static inline inputPort_t inputGetPort(pin_t* pin)
+{
+	if (pin == NULL)
+		return INPUT_PORT_NONE;
+	if (pin->PINR == &PINB)
+		return INPUT_PORT_B;
+	if (pin->PINR == &PINC)
+		return INPUT_PORT_C;
+	if (pin->PINR == &PIND)
+		return INPUT_PORT_D;
+	return INPUT_PORT_NONE;
+}
+
+#endif /* INPUT_H_ */
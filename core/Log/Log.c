@@ -1,5 +1,165 @@
+/*!	@brief System log messages
+ *
+ *	@author	inselc
+ *	@date 11.07.17		First implementation
+ *	@date 19.10.26		Deferred event records
+ *	@date 19.10.26		Compile-time log levels, PROGMEM tags
+ *	@date 19.10.26		Output via framed serial channels			*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <util/atomic.h>
+#include "../Serial/Serial.h"
+#include "../Serial/SerialFrame.h"
+#include "../Clock/Clock.h"
 #include "Log.h"
 
-const char* SRC_SYSTEM		= "[   SYS   ]";
-const char* SRC_ETHERNET	= "[   ETH   ]";
-const char* SRC_ETHERGB		= "[ ETHERGB ]";
\ No newline at end of file
+#define LOG_RECORD_COUNT	16		/* Event ring buffer size, power of two */
+#define LOG_RECORD_MASK		(LOG_RECORD_COUNT - 1)
+
+/*	Compiler memory barrier: keeps the record copy ahead of the tail
+	update, which hands the slot back to the writer					*/
+#define LOG_BARRIER()		__asm__ __volatile__ ("" ::: "memory")
+
+/*!	@struct logRecord_t
+ *	@brief Deferred log event record
+ *	@var logRecord_t::id
+ *	Event identifier (logEventId_t)
+ *	@var logRecord_t::arg
+ *	Event argument
+ *	@var logRecord_t::timestamp
+ *	Lower 16 bits of the system clock when the event was recorded	*/
+typedef struct {
+	uint8_t id;
+	uint16_t arg;
+	uint16_t timestamp;
+} logRecord_t;
+
+const char SRC_SYSTEM[] PROGMEM		= "[   SYS   ]";
+const char SRC_ETHERNET[] PROGMEM	= "[   ETH   ]";
+const char SRC_ETHERGB[] PROGMEM	= "[ ETHERGB ]";
+
+/*!	@brief Send a log message on the text channel
+ *
+ *	@param[in] src			Source tag (PROGMEM)
+ *	@param[in] msg			Message (PROGMEM)
+ *	@date 19.10.26			First implementation					*/
+void logWriteMessage(PGM_P src, PGM_P msg)
+{
+	serialFrameBegin(SERIAL_CHANNEL_LOG_TEXT);
+	serialFramePutStrP(src);
+	serialFramePut('\t');
+	serialFramePutStrP(msg);
+	serialFrameEnd();
+}
+
+/*!	@brief Send an error message on the text channel
+ *
+ *	@param[in] src			Source tag (PROGMEM)
+ *	@param[in] location		File and line (PROGMEM)
+ *	@param[in] msg			Message (PROGMEM)
+ *	@date 19.10.26			First implementation					*/
+void logWriteError(PGM_P src, PGM_P location, PGM_P msg)
+{
+	serialFrameBegin(SERIAL_CHANNEL_LOG_TEXT);
+	serialFramePutStrP(src);
+	serialFramePutStrP(PSTR("\tError in "));
+	serialFramePutStrP(location);
+	serialFramePut('\t');
+	serialFramePutStrP(msg);
+	serialFrameEnd();
+}
+
+#if LOG_EVENTS_ENABLED
+
+static logRecord_t logRecords[LOG_RECORD_COUNT];
+static volatile uint8_t logHead = 0;		//!< Write index (free-running)
+static volatile uint8_t logTail = 0;		//!< Read index (free-running)
+static volatile uint8_t logDropped = 0;		//!< Records lost to a full buffer
+
+/*!	@brief Record a deferred log event
+ *
+ *	Only stores the record; nothing is transmitted here. Safe to be
+ *	called from interrupt service routines.
+ *
+ *	@param[in] id			Event identifier (logEventId_t)
+ *	@param[in] arg			Event argument
+ *	@date 19.10.26			First implementation					*/
+void logEvent(uint8_t id, uint16_t arg)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		uint8_t head = logHead;
+		if ((uint8_t)(head - logTail) < LOG_RECORD_COUNT)
+		{
+			logRecord_t* record = &logRecords[head & LOG_RECORD_MASK];
+			record->id = id;
+			record->arg = arg;
+			record->timestamp = (uint16_t)clockMilliseconds;
+			logHead = head + 1;
+		}
+		else if (logDropped < UINT8_MAX)
+		{
+			++logDropped;
+		}
+	}
+}
+
+/*!	@brief Transmit a single event record
+ *
+ *	Frame payload: id, argument, timestamp (both MSB first).
+ *
+ *	@param[in] *record		Record to transmit
+ *	@date 19.10.26			First implementation					*/
+static void logWriteRecord(logRecord_t* record)
+{
+	uint8_t payload[5];
+	payload[0] = record->id;
+	payload[1] = record->arg >> 8;
+	payload[2] = record->arg & 0xFF;
+	payload[3] = record->timestamp >> 8;
+	payload[4] = record->timestamp & 0xFF;
+
+	serialFrameWrite(SERIAL_CHANNEL_LOG_EVENT, payload, sizeof(payload));
+}
+
+/*!	@brief Transmit the oldest pending event record
+ *
+ *	To be called from idle time. Sends at most one record per call,
+ *	so the time spent here stays bounded.
+ *
+ *	@return bool			true, if a record was sent
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Barrier before releasing the record		*/
+bool logFlush(void)
+{
+	logRecord_t record;
+	uint8_t tail = logTail;
+
+	if (logHead != tail)
+	{
+		record = logRecords[tail & LOG_RECORD_MASK];
+		LOG_BARRIER();
+		logTail = tail + 1;
+	}
+	else if (logDropped > 0)
+	{
+		// Report lost records once the backlog has been sent
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			record.arg = logDropped;
+			logDropped = 0;
+		}
+		record.id = LOG_EVT_LOG_DROPPED;
+		record.timestamp = clockMillis16();
+	}
+	else
+	{
+		return false;
+	}
+
+	logWriteRecord(&record);
+	return true;
+}
+
+#endif /* LOG_EVENTS_ENABLED */
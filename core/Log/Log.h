@@ -1,25 +1,58 @@
 /*!	@brief System log messages
+ *
+ *	LOG_MESSAGE/LOG_ERROR print synchronously and are meant for init
+ *	and fatal errors. LOG_EVENT stores a compact record in a RAM ring
+ *	buffer instead, which logFlush transmits later from idle time.
+ *	Which of them are compiled in is set per source in LogConfig.h.
+ *	Both are sent as frames on their own serial channel.
  *
  *	@author	inselc
  *	@date 11.07.17		First implementation
- *	@date 23.07.17		String helpers moved to stringtools			*/
+ *	@date 23.07.17		String helpers moved to stringtools
+ *	@date 19.10.26		Deferred event records
+ *	@date 19.10.26		Compile-time log levels, PROGMEM tags
+ *	@date 19.10.26		Output via framed serial channels
+ *	@date 19.10.26		LOG_CRASH as a single statement				*/
 
 #ifndef LOG_H_
 #define LOG_H_
 
 /*!	@file */
 
+#include <stdint.h>
+#include <stdbool.h>
 #include <avr/pgmspace.h>
+#include "LogConfig.h"
+#include "LogEvents.h"
 
 #define STR_HELPER(x) #x
 #define STR(x) STR_HELPER(x)
 
-extern const char* SRC_SYSTEM;
-extern const char* SRC_ETHERNET;
-extern const char* SRC_ETHERGB;
+extern const char SRC_SYSTEM[] PROGMEM;
+extern const char SRC_ETHERNET[] PROGMEM;
+extern const char SRC_ETHERGB[] PROGMEM;
+
+void logWriteMessage(PGM_P src, PGM_P msg);
+void logWriteError(PGM_P src, PGM_P location, PGM_P msg);
+
+#if LOG_EVENTS_ENABLED
+void logEvent(uint8_t id, uint16_t arg);
+bool logFlush(void);
+#else
+/*!	@brief Placeholder while no source records deferred events
+ *
+ *	@return bool			false
+ *	@date 19.10.26			First implementation					*/
+static inline bool logFlush(void)
+{
+	return false;
+}
+#endif
 
-#define LOG_MESSAGE(src,msg)	serialWriteStr(src); serialWriteStrP(PSTR("\t" msg "\r\n"))
-#define LOG_ERROR(src,msg)		serialWriteStr(src); serialWriteStrP(PSTR("\tError in " __FILE__ ":" STR(__LINE__) "\t")); serialWriteStrP(PSTR(msg "\r\n"))
-#define LOG_CRASH(src,msg)		LOG_ERROR(src,msg); while(1);
+#define LOG_MESSAGE(src,msg)	LOG_ON_INFO_##src(logWriteMessage(src, PSTR(msg)))
+#define LOG_DEBUG(src,msg)		LOG_ON_DEBUG_##src(logWriteMessage(src, PSTR(msg)))
+#define LOG_ERROR(src,msg)		LOG_ON_ERROR_##src(logWriteError(src, PSTR(__FILE__ ":" STR(__LINE__)), PSTR(msg)))
+#define LOG_CRASH(src,msg)		do { LOG_ERROR(src,msg); for (;;); } while (0)
+#define LOG_EVENT(src,id,arg)	LOG_ON_WARN_##src(logEvent((id), (arg)))
 
-#endif /* LOG_H_ */
\ No newline at end of file
+#endif /* LOG_H_ */
@@ -0,0 +1,121 @@
+/*!	@brief Compile-time log level configuration
+ *
+ *	Every log source has its own level, which can be overridden on
+ *	the compiler command line, e.g. -DLOG_LEVEL_ETHERGB=LOG_LEVEL_DEBUG.
+ *	Messages above a source's level expand to nothing, so neither
+ *	code nor flash strings are left behind for them.
+ *
+ *	Defaults: LOG_LEVEL_WARN for NDEBUG (production) builds, so
+ *	errors reported as deferred events are kept, LOG_LEVEL_DEBUG
+ *	otherwise.
+ *
+ *	@author	inselc
+ *	@date 19.10.26		First implementation
+ *	@date 19.10.26		Keep events in NDEBUG builds				*/
+
+#ifndef LOGCONFIG_H_
+#define LOGCONFIG_H_
+
+/*!	@file */
+
+#define LOG_LEVEL_NONE		0	/*!< No output at all						*/
+#define LOG_LEVEL_ERROR		1	/*!< LOG_ERROR, LOG_CRASH					*/
+#define LOG_LEVEL_WARN		2	/*!< LOG_EVENT (deferred records)			*/
+#define LOG_LEVEL_INFO		3	/*!< LOG_MESSAGE							*/
+#define LOG_LEVEL_DEBUG		4	/*!< LOG_DEBUG								*/
+
+#ifndef LOG_LEVEL_DEFAULT
+#if defined(NDEBUG)
+#define LOG_LEVEL_DEFAULT	LOG_LEVEL_WARN
+#else
+#define LOG_LEVEL_DEFAULT	LOG_LEVEL_DEBUG
+#endif
+#endif
+
+#ifndef LOG_LEVEL_SYSTEM
+#define LOG_LEVEL_SYSTEM	LOG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_LEVEL_ETHERNET
+#define LOG_LEVEL_ETHERNET	LOG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_LEVEL_ETHERGB
+#define LOG_LEVEL_ETHERGB	LOG_LEVEL_DEFAULT
+#endif
+
+/*	Per-source level switches: LOG_ON_<LEVEL>_<SRC>(code) keeps code
+	only if the source's level includes <LEVEL>						*/
+
+// SRC_SYSTEM
+#if LOG_LEVEL_SYSTEM >= LOG_LEVEL_ERROR
+#define LOG_ON_ERROR_SRC_SYSTEM(...)	__VA_ARGS__
+#else
+#define LOG_ON_ERROR_SRC_SYSTEM(...)
+#endif
+#if LOG_LEVEL_SYSTEM >= LOG_LEVEL_WARN
+#define LOG_ON_WARN_SRC_SYSTEM(...)		__VA_ARGS__
+#else
+#define LOG_ON_WARN_SRC_SYSTEM(...)
+#endif
+#if LOG_LEVEL_SYSTEM >= LOG_LEVEL_INFO
+#define LOG_ON_INFO_SRC_SYSTEM(...)		__VA_ARGS__
+#else
+#define LOG_ON_INFO_SRC_SYSTEM(...)
+#endif
+#if LOG_LEVEL_SYSTEM >= LOG_LEVEL_DEBUG
+#define LOG_ON_DEBUG_SRC_SYSTEM(...)	__VA_ARGS__
+#else
+#define LOG_ON_DEBUG_SRC_SYSTEM(...)
+#endif
+
+// SRC_ETHERNET
+#if LOG_LEVEL_ETHERNET >= LOG_LEVEL_ERROR
+#define LOG_ON_ERROR_SRC_ETHERNET(...)	__VA_ARGS__
+#else
+#define LOG_ON_ERROR_SRC_ETHERNET(...)
+#endif
+#if LOG_LEVEL_ETHERNET >= LOG_LEVEL_WARN
+#define LOG_ON_WARN_SRC_ETHERNET(...)	__VA_ARGS__
+#else
+#define LOG_ON_WARN_SRC_ETHERNET(...)
+#endif
+#if LOG_LEVEL_ETHERNET >= LOG_LEVEL_INFO
+#define LOG_ON_INFO_SRC_ETHERNET(...)	__VA_ARGS__
+#else
+#define LOG_ON_INFO_SRC_ETHERNET(...)
+#endif
+#if LOG_LEVEL_ETHERNET >= LOG_LEVEL_DEBUG
+#define LOG_ON_DEBUG_SRC_ETHERNET(...)	__VA_ARGS__
+#else
+#define LOG_ON_DEBUG_SRC_ETHERNET(...)
+#endif
+
+// SRC_ETHERGB
+#if LOG_LEVEL_ETHERGB >= LOG_LEVEL_ERROR
+#define LOG_ON_ERROR_SRC_ETHERGB(...)	__VA_ARGS__
+#else
+#define LOG_ON_ERROR_SRC_ETHERGB(...)
+#endif
+#if LOG_LEVEL_ETHERGB >= LOG_LEVEL_WARN
+#define LOG_ON_WARN_SRC_ETHERGB(...)	__VA_ARGS__
+#else
+#define LOG_ON_WARN_SRC_ETHERGB(...)
+#endif
+#if LOG_LEVEL_ETHERGB >= LOG_LEVEL_INFO
+#define LOG_ON_INFO_SRC_ETHERGB(...)	__VA_ARGS__
+#else
+#define LOG_ON_INFO_SRC_ETHERGB(...)
+#endif
+#if LOG_LEVEL_ETHERGB >= LOG_LEVEL_DEBUG
+#define LOG_ON_DEBUG_SRC_ETHERGB(...)	__VA_ARGS__
+#else
+#define LOG_ON_DEBUG_SRC_ETHERGB(...)
+#endif
+
+/*	Deferred event records are only needed, if any source uses them	*/
+#if (LOG_LEVEL_SYSTEM >= LOG_LEVEL_WARN) || (LOG_LEVEL_ETHERNET >= LOG_LEVEL_WARN) || (LOG_LEVEL_ETHERGB >= LOG_LEVEL_WARN)
+#define LOG_EVENTS_ENABLED	1
+#else
+#define LOG_EVENTS_ENABLED	0
+#endif
+
+#endif /* LOGCONFIG_H_ */
@@ -0,0 +1,50 @@
+/*!	@brief Deferred log event identifiers
+ *
+ *	Every deferred log record only carries the index of its entry in
+ *	this list. The message texts are not compiled into the firmware;
+ *	tools/LogDecode.py reads them from this file to decode captured
+ *	records. Only append new entries, or captures from older firmware
+ *	will no longer decode correctly.
+ *
+ *	Texts may contain a single printf-style conversion for the 16-bit
+ *	record argument.
+ *
+ *	@author	inselc
+ *	@date 19.10.26		First implementation
+ *	@date 19.10.26		Color slot event							*/
+
+#ifndef LOGEVENTS_H_
+#define LOGEVENTS_H_
+
+/*!	@file */
+
+#define LOG_EVENT_LIST(ENTRY) \
+	ENTRY(LOG_EVT_LOG_DROPPED,				"Log: %u records dropped") \
+	ENTRY(LOG_EVT_SERIAL_INVALID_START,		"Serial: got invalid start byte 0x%02X") \
+	ENTRY(LOG_EVT_SERIAL_INVALID_COMMAND,	"Serial: got invalid command byte 0x%02X") \
+	ENTRY(LOG_EVT_SERIAL_INVALID_CHECKSUM,	"Serial: got invalid checksum (received << 8 | expected = 0x%04X)") \
+	ENTRY(LOG_EVT_SERIAL_TIMEOUT,			"Serial: connection timed out in state %u") \
+	ENTRY(LOG_EVT_ETH_SOCKET_REOPEN,		"Ethernet: socket %u closed, reopening") \
+	ENTRY(LOG_EVT_ETH_SOCKET_DISCONNECT,	"Ethernet: socket %u closing, disconnecting") \
+	ENTRY(LOG_EVT_ETH_SOCKET_CLOSED,		"Ethernet: socket %u closed") \
+	ENTRY(LOG_EVT_ETH_MESSAGE_TOO_SHORT,	"Ethernet: message too short (%u bytes)") \
+	ENTRY(LOG_EVT_ETH_INVALID_START,		"Ethernet: got invalid start byte 0x%02X") \
+	ENTRY(LOG_EVT_ETH_INVALID_COMMAND,		"Ethernet: got invalid command byte 0x%02X") \
+	ENTRY(LOG_EVT_ETH_DATA_TOO_LONG,		"Ethernet: data too long (%u bytes)") \
+	ENTRY(LOG_EVT_ETH_INVALID_CHECKSUM,		"Ethernet: got invalid checksum (received << 8 | expected = 0x%04X)") \
+	ENTRY(LOG_EVT_ETH_TIMEOUT,				"Ethernet: connection timed out on socket %u") \
+	ENTRY(LOG_EVT_DIMMER_INVALID_CHANNEL,	"Dimmer: channel %u out of bounds") \
+	ENTRY(LOG_EVT_CMD_TEST,					"Command: test command received") \
+	ENTRY(LOG_EVT_CMD_GROUP_OUT_OF_RANGE,	"Command: group start %u out of range") \
+	ENTRY(LOG_EVT_CMD_COLOR_SLOTS_BUSY,		"Command: all color slots fading, group start %u")
+
+#define LOG_EVENT_ENUM_ENTRY(id, text)	id,
+
+/*!	@enum logEventId_t
+ *	@brief Deferred log event identifiers						*/
+typedef enum {
+	LOG_EVENT_LIST(LOG_EVENT_ENUM_ENTRY)
+	LOG_EVT_COUNT
+} logEventId_t;
+
+#endif /* LOGEVENTS_H_ */
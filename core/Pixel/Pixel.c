@@ -0,0 +1,189 @@
+/*!	@brief Addressable LED strip output
+ *
+ *	The strip protocol encodes every bit in a 1.25us high/low period,
+ *	a short high time being a 0 and a long one a 1. At 16MHz, a bit
+ *	is 20 CPU cycles: high for 6 cycles (375ns) for a 0 and for 13
+ *	cycles (812ns) for a 1. The transmitter loop is counted to the
+ *	cycle, so interrupts are disabled while it runs - but only for
+ *	one pixel at a time (30us for GRB). Pending interrupts are served
+ *	between pixels; the strip only latches after more than 50us low,
+ *	which no ISR of this firmware comes near.
+ *
+ *	pixelShow is called from the main loop, when no command is
+ *	pending, so frames never delay or interleave with the SPI
+ *	transfers of the W5100. A burst of pixel commands results in a
+ *	single frame.
+ *
+ *	@author inselc
+ *	@date 19.10.26			First implementation					*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <util/atomic.h>
+#include "../Clock/Clock.h"
+#include "Pixel.h"
+
+#if PIXEL_ENABLED
+static uint8_t pixelFrame[PIXEL_COUNT * PIXEL_BYTES];	//!< Frame buffer, in wire order
+static bool pixelDirty = false;							//!< Frame buffer changed since the last frame
+static uint16_t pixelLastFrame = 0;						//!< End of the last frame, in ms
+
+/*!	@brief Transmit bytes to the strip
+ *
+ *	Must be called with interrupts disabled. The output register is
+ *	read once, so the other pins of the port must not change while
+ *	transmitting.
+ *
+ *	@param[in] *data		Bytes, in wire order
+ *	@param[in] count		Number of bytes, at least 1
+ *	@date 19.10.26			First implementation					*/
+static void pixelSendBytes(const uint8_t* data, uint8_t count)
+{
+	uint8_t high = PIXEL_PORT | (1 << PIXEL_PIN);
+	uint8_t low = PIXEL_PORT & ~(1 << PIXEL_PIN);
+	uint8_t byte;
+	uint8_t bits;
+
+	__asm__ __volatile__ (
+		"1:	ld		%[byte], %a[data]+	\n\t"
+		"	ldi		%[bits], 8			\n\t"
+		"2:	out		%[port], %[high]	\n\t"	// 0: rising edge
+		"	nop						\n\t"
+		"	nop						\n\t"
+		"	nop						\n\t"
+		"	nop						\n\t"
+		"	sbrs	%[byte], 7			\n\t"	// 5
+		"	out		%[port], %[low]		\n\t"	// 6: falling edge of a 0
+		"	lsl		%[byte]				\n\t"	// 7
+		"	nop						\n\t"
+		"	nop						\n\t"
+		"	nop						\n\t"
+		"	nop						\n\t"
+		"	nop						\n\t"
+		"	out		%[port], %[low]		\n\t"	// 13: falling edge of a 1
+		"	nop						\n\t"
+		"	nop						\n\t"
+		"	nop						\n\t"
+		"	dec		%[bits]				\n\t"	// 17
+		"	brne	2b					\n\t"	// 18..19
+		"	dec		%[count]			\n\t"
+		"	brne	1b					\n\t"
+		: [byte] "=&r" (byte), [bits] "=&d" (bits), [count] "+r" (count), [data] "+e" (data)
+		: [port] "I" (_SFR_IO_ADDR(PIXEL_PORT)), [high] "r" (high), [low] "r" (low)
+	);
+}
+#endif
+
+/*!	@brief Initialise the strip output
+ *
+ *	All pixels are turned off with the first frame.
+ *
+ *	@date 19.10.26			First implementation					*/
+void pixelInit(void)
+{
+#if PIXEL_ENABLED
+	PIXEL_PORT &= ~(1 << PIXEL_PIN);
+	PIXEL_DDR |= 1 << PIXEL_PIN;
+
+	pixelLastFrame = clockMillis16();
+	pixelDirty = true;
+#endif
+}
+
+/*!	@brief Set a pixel's color
+ *
+ *	@param[in] index		Pixel index
+ *	@param[in] *color		Red, green, blue (and white) values
+ *	@return bool			false, if the index is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool pixelSet(uint16_t index, const uint8_t* color)
+{
+	return pixelFill(index, 1, color);
+}
+
+/*!	@brief Set a range of pixels to one color
+ *
+ *	@param[in] index		First pixel index
+ *	@param[in] count		Number of pixels
+ *	@param[in] *color		Red, green, blue (and white) values
+ *	@return bool			false, if the range is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool pixelFill(uint16_t index, uint16_t count, const uint8_t* color)
+{
+	if ((index >= PIXEL_COUNT) || (count > PIXEL_COUNT - index) || (color == NULL))
+		return false;
+
+#if PIXEL_ENABLED
+	uint8_t* pixel = &pixelFrame[index * PIXEL_BYTES];
+	while (count--)
+	{
+		pixel[0] = color[1];
+		pixel[1] = color[0];
+		pixel[2] = color[2];
+#if PIXEL_BYTES == 4
+		pixel[3] = color[3];
+#endif
+		pixel += PIXEL_BYTES;
+	}
+	pixelDirty = true;
+#endif
+	return true;
+}
+
+/*!	@brief Read a pixel's color
+ *
+ *	@param[in] index		Pixel index
+ *	@param[out] *color		Red, green, blue (and white) values
+ *	@return bool			false, if the index is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool pixelGet(uint16_t index, uint8_t* color)
+{
+	if ((index >= PIXEL_COUNT) || (color == NULL))
+		return false;
+
+#if PIXEL_ENABLED
+	const uint8_t* pixel = &pixelFrame[index * PIXEL_BYTES];
+	color[0] = pixel[1];
+	color[1] = pixel[0];
+	color[2] = pixel[2];
+#if PIXEL_BYTES == 4
+	color[3] = pixel[3];
+#endif
+#endif
+	return true;
+}
+
+/*!	@brief Transmit the frame buffer, if it has changed
+ *
+ *	Blocks for 30us (GRB) or 40us (GRBW) per pixel.
+ *
+ *	@return bool			true, if a frame has been transmitted
+ *	@date 19.10.26			First implementation					*/
+bool pixelShow(void)
+{
+#if PIXEL_ENABLED
+	if (!pixelDirty)
+		return false;
+
+	// Let the strip latch the previous frame
+	if ((uint16_t)(clockMillis16() - pixelLastFrame) < PIXEL_LATCH_MS)
+		return false;
+
+	pixelDirty = false;
+	const uint8_t* pixel = pixelFrame;
+	for (uint16_t i = 0; i < PIXEL_COUNT; ++i)
+	{
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			pixelSendBytes(pixel, PIXEL_BYTES);
+		}
+		pixel += PIXEL_BYTES;
+	}
+
+	pixelLastFrame = clockMillis16();
+	return true;
+#else
+	return false;
+#endif
+}
@@ -0,0 +1,65 @@
+/*!	@brief Addressable LED strip output
+ *
+ *	Drives a WS2812 (CONF_PIXEL_USE_WS2812, GRB) or SK6812 RGBW
+ *	(CONF_PIXEL_USE_SK6812, GRBW) strip of CONF_PIXEL_COUNT pixels
+ *	at PB1. The frame buffer holds the pixels in wire order; a frame
+ *	is only transmitted after pixels have changed. Without either
+ *	option, the strip is disabled and all pixel indices are invalid.
+ *
+ *	The transmitter is cycle counted for a 16MHz CPU clock.
+ *
+ *	The frame buffer is limited to PIXEL_MAX_FRAME_BYTES, since the
+ *	ATmega328P has 2 KB of RAM for all modules.
+ *
+ *	@author inselc
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Frame buffer RAM budget					*/
+
+#ifndef PIXEL_H_
+#define PIXEL_H_
+
+/*!	@file */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <avr/io.h>
+
+#if defined(CONF_PIXEL_USE_SK6812)
+#define PIXEL_ENABLED			1
+#define PIXEL_BYTES				4		/* G, R, B, W */
+#elif defined(CONF_PIXEL_USE_WS2812)
+#define PIXEL_ENABLED			1
+#define PIXEL_BYTES				3		/* G, R, B */
+#else
+#define PIXEL_ENABLED			0
+#define PIXEL_BYTES				3
+#endif
+
+#if PIXEL_ENABLED
+#ifndef CONF_PIXEL_COUNT
+#define CONF_PIXEL_COUNT		50		/* Pixels in the strip, 3 or 4 bytes of RAM each */
+#endif
+#define PIXEL_COUNT				CONF_PIXEL_COUNT
+#else
+#define PIXEL_COUNT				0
+#endif
+
+#ifndef PIXEL_MAX_FRAME_BYTES
+#define PIXEL_MAX_FRAME_BYTES	240		/* RAM budget of the frame buffer */
+#endif
+#if PIXEL_COUNT * PIXEL_BYTES > PIXEL_MAX_FRAME_BYTES
+#error "CONF_PIXEL_COUNT exceeds the frame buffer's RAM budget (PIXEL_MAX_FRAME_BYTES)"
+#endif
+
+#define PIXEL_PORT				PORTB
+#define PIXEL_DDR				DDRB
+#define PIXEL_PIN				PB1
+#define PIXEL_LATCH_MS			2		/* Idle time between frames, at least 280us */
+
+void pixelInit(void);
+bool pixelSet(uint16_t index, const uint8_t* color);
+bool pixelFill(uint16_t index, uint16_t count, const uint8_t* color);
+bool pixelGet(uint16_t index, uint8_t* color);
+bool pixelShow(void);
+
+#endif /* PIXEL_H_ */
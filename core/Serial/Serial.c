@@ -1,74 +1,82 @@
 /*! @brief Serial communication over USART
  *
  *	@author	inselc
- *	@date	05.12.16	initial version								*/ 
+ *	@date	05.12.16	initial version
+ *	@date	19.10.26	Lock-free SPSC receive ring buffer
+ *	@date	19.10.26	Disabled while the dimmer uses the USART	*/ 
 
 /*! @file */
 
+#include <string.h>
 #include <avr/interrupt.h>
 #include "Serial.h"
 
-/*! @brief Push data into receive ring buffer
+/*	Compiler memory barrier: keeps data accesses on the correct side
+	of the head/tail index update									*/
+#define SERIAL_BARRIER()	__asm__ __volatile__ ("" ::: "memory")
+
+/*! @struct serialRingBuffer_t
+ *	USART Receive data ring buffer (single producer, single consumer)
  *
- *	@param[in] data			Data to be pushed into the buffer
- *	@return bool			false, if write failed (buffer full)
- *	@date 07.12.16			first implementation					*/
-static bool serialPushRxBuf(uint8_t data)
+ *	The indices are free-running and only masked on access, so the
+ *	fill level is always (head - tail), and a full buffer can be told
+ *	apart from an empty one without additional flags.
+ *
+ *	@var serialRingBuffer_t::head
+ *	Write index, only modified by the USART RX ISR
+ *	@var serialRingBuffer_t::tail
+ *	Read index, only modified by the main loop
+ *	@var serialRingBuffer_t::overflows
+ *	Number of bytes dropped because the buffer was full
+ *  @var serialRingBuffer_t::data
+ *	Data array														*/
+typedef struct tagSerialRingBuffer_t
 {
-	// Check buffer full
-	if (serialRxBuf.full)
-	{
-		return false;
-	}
+	volatile uint8_t head;
+	volatile uint8_t tail;
+	volatile uint8_t overflows;
+	uint8_t data[SERIAL_BUF_SIZE];
+} serialRingBuffer_t;
 
-	// Clear buffer empty flag
-	serialRxBuf.empty = false;
-	
-	// Write data into buffer
-	serialRxBuf.data[serialRxBuf.head] = data;
-	
-	// Advance head pointer
-	serialRxBuf.head = (serialRxBuf.head + 1) % SERIAL_BUF_SIZE;
+static serialRingBuffer_t serialRxBuf;
 
-	// Recalculate buffer full flag
-	if (serialRxBuf.head == serialRxBuf.tail)
-	{
-		serialRxBuf.full = true;
-	}
-
-	return true;
-}
-
-/*! @brief Pop data from receive ring buffer
+/*! @brief Copy data from the receive ring buffer
  *
- *	@return uint8_t			Data at buffer tail. 0x00, if buffer empty
- *	@date 07.12.16			first implementation					*/
-static uint8_t serialPopRxBuf(void)
+ *	Copies at most two contiguous spans (up to the end of the data
+ *	array, and from its beginning) and releases them in one step.
+ *
+ *	@param[out] *buffer		Target buffer
+ *	@param[in] count		Maximum number of bytes to copy
+ *	@return uint8_t			Number of bytes copied
+ *	@date 19.10.26			first implementation					*/
+static uint8_t serialCopyRxBuf(uint8_t* buffer, uint8_t count)
 {
-	uint8_t data;
-	if (serialRxBuf.empty)
+	uint8_t tail = serialRxBuf.tail;
+	uint8_t available = serialRxBuf.head - tail;
+	SERIAL_BARRIER();
+
+	if (count > available)
 	{
-		return 0x00;
+		count = available;
 	}
-	else
-	{
-		// Clear buffer full flag
-		serialRxBuf.full = false;
 
-		// Read data from buffer
-		data = serialRxBuf.data[serialRxBuf.tail];
+	// First span: from tail to the end of the data array
+	uint8_t index = tail & SERIAL_BUF_MASK;
+	uint8_t span = SERIAL_BUF_SIZE - index;
+	if (span > count)
+	{
+		span = count;
+	}
+	memcpy(buffer, &serialRxBuf.data[index], span);
 
-		// Advance tail pointer
-		serialRxBuf.tail = (serialRxBuf.tail + 1) % SERIAL_BUF_SIZE;
+	// Second span: wrapped part from the start of the data array
+	memcpy(buffer + span, serialRxBuf.data, count - span);
 
-		// Check buffer empty
-		if (serialRxBuf.tail == serialRxBuf.head)
-		{
-			serialRxBuf.empty = true;
-		}
+	// Release the copied bytes to the producer
+	SERIAL_BARRIER();
+	serialRxBuf.tail = tail + count;
 
-		return data;
-	}
+	return count;
 }
 
 /*! @brief Read from serial into buffer, until ring buffer is empty
@@ -77,7 +85,8 @@ static uint8_t serialPopRxBuf(void)
  *	@param[in] bufSize		Maximum buffer size
  *	@param[in] timeout		Cycles until timeout (-1: infinite)
  *	@return uint8_t			Number of bytes read
- *	@date 07.12.16			first implementation					*/
+ *	@date 07.12.16			first implementation
+ *	@date 19.10.26			Copy contiguous spans					*/
 uint8_t serialReadBuf(uint8_t* buffer, uint8_t bufSize, int timeout)
 {
 	uint8_t byteCount = 0;
@@ -88,21 +97,24 @@ uint8_t serialReadBuf(uint8_t* buffer, uint8_t bufSize, int timeout)
 		return 0x00;
 
 	// read until ring buffer is empty or target buffer is full
-	while (byteCount < bufSize && (timeoutCount < timeout || timeout < 0))
+	while (byteCount < bufSize)
 	{
-		if (serialRxBuf.empty)
+		uint8_t copied = serialCopyRxBuf(buffer + byteCount, bufSize - byteCount);
+		if (copied > 0)
+		{
+			byteCount += copied;
+
+			// Reset timeout counter
+			timeoutCount = 0;
+		}
+		else if (timeoutCount < timeout || timeout < 0)
 		{
 			// Buffer is empty, wait for timeout
 			timeoutCount = (timeoutCount + 1) % INT_MAX;
 		}
 		else
 		{
-			// Buffer is not empty. Read data
-			buffer[byteCount] = serialPopRxBuf();
-			byteCount++;
-
-			// Reset timeout counter
-			timeoutCount = 0;
+			break;
 		}
 	}
 
@@ -131,13 +143,13 @@ uint8_t serialReadBufUntil(uint8_t* buffer, uint8_t bufSize, char stopChar, int
 
 	while(byteCounter < bufSize && (timeoutCount < timeout || timeout < 0))
 	{
-		if (serialRxBuf.empty)
+		if (serialAvailable() == 0)
 		{
 				timeoutCount = (timeoutCount + 1) % INT_MAX;
 		}
 		else
 		{
-			buffer[byteCounter] = serialPopRxBuf();
+			buffer[byteCounter] = serialRead();
 			timeoutCount = 0;
 			byteCounter++;
 			
@@ -159,9 +171,11 @@ uint8_t serialReadBufUntil(uint8_t* buffer, uint8_t bufSize, char stopChar, int
  *	@date 07.12.16			first implementation					*/
 uint8_t serialPeek(void)
 {
-	if (!serialRxBuf.empty)
+	uint8_t tail = serialRxBuf.tail;
+	if (serialRxBuf.head != tail)
 	{
-		return serialRxBuf.data[serialRxBuf.tail];
+		SERIAL_BARRIER();
+		return serialRxBuf.data[tail & SERIAL_BUF_MASK];
 	}
 	else
 	{
@@ -172,19 +186,41 @@ uint8_t serialPeek(void)
 /*! @brief Get number of available bytes in ring buffer
  *
  *  @return uint8_t			Number of unread bytes
- *	@date 07.12.16			first implementation					*/
+ *	@date 07.12.16			first implementation
+ *	@date 19.10.26			Free-running indices					*/
 uint8_t serialAvailable(void)
 {
-	return ((serialRxBuf.head + SERIAL_BUF_SIZE - serialRxBuf.tail) % SERIAL_BUF_SIZE);
+	return (uint8_t)(serialRxBuf.head - serialRxBuf.tail);
+}
+
+/*! @brief Get number of bytes dropped due to a full receive buffer
+ *
+ *	@return uint8_t			Overflow count (wraps around)
+ *	@date 19.10.26			first implementation					*/
+uint8_t serialGetOverflowCount(void)
+{
+	return serialRxBuf.overflows;
 }
 
 /*! @brief Read single byte from RX ring buffer
  *
  *	@return	uint8_t			Byte from ring buffer, 0x00 if empty
- *	@date 07.12.16			first implementation					*/
+ *	@date 07.12.16			first implementation
+ *	@date 19.10.26			Consumer only updates the tail index	*/
 uint8_t serialRead(void)
 {
-	return serialPopRxBuf();
+	uint8_t tail = serialRxBuf.tail;
+	if (serialRxBuf.head == tail)
+	{
+		return 0x00;
+	}
+
+	SERIAL_BARRIER();
+	uint8_t data = serialRxBuf.data[tail & SERIAL_BUF_MASK];
+	SERIAL_BARRIER();
+	serialRxBuf.tail = tail + 1;
+
+	return data;
 }
 
 /*!	@brief Ouput a single byte via serial connection
@@ -196,6 +232,9 @@ uint8_t serialRead(void)
  *	@date 08.07.17				First implementation				*/
 void serialWriteChar(char data)
 {
+#if !SERIAL_ENABLED
+	return;
+#endif
 	usartWaitDREmpty();
 	usartSendData(data);
 }
@@ -217,6 +256,9 @@ int serialWriteStr(const char* message)
 	{
 		return -1;
 	}
+#if !SERIAL_ENABLED
+	return 0;
+#endif
 
 	// Transmit message, including trailing \0
 	// Abort, if maximum string length exceeded
@@ -241,6 +283,9 @@ int serialWriteStr(const char* message)
 int serialWriteStrP(PGM_P message) 
 {
 	int stringPos = 0;
+#if !SERIAL_ENABLED
+	return 0;
+#endif
 	char msgChar = (char)pgm_read_byte(message);
 
 	while ((msgChar != '\0') && (stringPos < SERIAL_MAX_STRLEN))
@@ -272,6 +317,9 @@ uint16_t serialWriteBuf(uint8_t* data, uint16_t count, int timeout)
 	// Null-pointer exception
 	if (data == NULL)
 		return 0;
+#if !SERIAL_ENABLED
+	return count;
+#endif
 
 	while (byteCounter < count && (timeoutCount < timeout || timeout < 0))
 	{
@@ -294,23 +342,34 @@ uint16_t serialWriteBuf(uint8_t* data, uint16_t count, int timeout)
 
 /*! @brief Discard remaining data in receive ring buffer
  *
- *	@date 07.12.16				first implementation				*/
+ *	@date 07.12.16				first implementation
+ *	@date 19.10.26				Only touch the consumer index		*/
 void serialFlush(void)
 {
-	serialRxBuf.head = 0;
-	serialRxBuf.tail = 0;
-	serialRxBuf.empty = true;
-	serialRxBuf.full = false;
+	serialRxBuf.tail = serialRxBuf.head;
 }
 
 // -----------------------------------------------------------------
 
 /*! @brief USART Receive ISR: read data into ring buffer
  *
- *	@date 07.12.16				first implementation				*/
+ *	@date 07.12.16				first implementation
+ *	@date 19.10.26				Only touch the producer index		*/
 ISR(USART_RX_vect)
 {
 	// copy data from USART buffer into ring buffer
 	// this read from UDR will automatically clear the RXC flag
-	serialPushRxBuf(usartReadData());
+	uint8_t data = usartReadData();
+	uint8_t head = serialRxBuf.head;
+
+	if ((uint8_t)(head - serialRxBuf.tail) < SERIAL_BUF_SIZE)
+	{
+		serialRxBuf.data[head & SERIAL_BUF_MASK] = data;
+		SERIAL_BARRIER();
+		serialRxBuf.head = head + 1;
+	}
+	else
+	{
+		++serialRxBuf.overflows;
+	}
 }
\ No newline at end of file
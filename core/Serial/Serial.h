@@ -1,7 +1,9 @@
 /*! @brief Serial communication over USART
  *
  *	@author	inselc
- *	@date	05.12.16	initial version								*/ 
+ *	@date	05.12.16	initial version
+ *	@date	19.10.26	Lock-free SPSC receive ring buffer
+ *	@date	19.10.26	Disabled while the dimmer uses the USART	*/ 
 
 #ifndef SERIAL_H_
 #define SERIAL_H_
@@ -17,30 +19,20 @@
 #include "../../modules/usart/usart_rs232.h"
 
 #define SERIAL_MAX_STRLEN	64		/* maximum string length for tx	*/
-#define SERIAL_BUF_SIZE		64		/* receive ringbuffer size		*/
+#define SERIAL_BUF_SIZE		128		/* receive ringbuffer size		*/
+#define SERIAL_BUF_MASK		(SERIAL_BUF_SIZE - 1)
 
-/*! @struct serialRingBuffer_t
- *	USART Receive data ring buffer
- *	@var serialRingBuffer_t::head
- *	Ring buffer head index
- *	@var serialRingBuffer_t::tail
- *	Ring buffer tail index
- *	@var serialRingBuffer_t::empty
- *	Ring buffer EMPTY flag
- *	@var serialRingBuffer_t::full
- *	Ring buffer FULL flag
- *  @var serialRingBuffer_t::data
- *	Data array														*/
-typedef volatile struct tagSerialRingBuffer_t
-{
-	uint8_t head;
-	uint8_t tail;
-	bool empty;
-	bool full;
-	uint8_t data[SERIAL_BUF_SIZE];
-} serialRingBuffer_t;
+/*	The 74HC595 dimmer backend runs the USART in master SPI mode,
+	serial output is dropped and nothing is received				*/
+#if defined(CONF_DIMMER_USE_HC595)
+#define SERIAL_ENABLED		0
+#else
+#define SERIAL_ENABLED		1
+#endif
 
-static serialRingBuffer_t serialRxBuf;
+#if (SERIAL_BUF_SIZE & SERIAL_BUF_MASK) || (SERIAL_BUF_SIZE > 128)
+#error "SERIAL_BUF_SIZE must be a power of two, not larger than 128"
+#endif
 
 /* Prototypes */
 uint8_t serialAvailable(void);
@@ -48,6 +40,7 @@ uint8_t serialReadBuf(uint8_t* buffer, uint8_t bufSize, int timeout);
 uint8_t serialReadBufUntil(uint8_t* buffer, uint8_t bufSize, char stopChar, int timeout);
 uint8_t serialRead(void);
 uint8_t serialPeek(void);
+uint8_t serialGetOverflowCount(void);
 void serialWriteChar(char data);
 int serialWriteStr(const char* message);
 int serialWriteStrP(PGM_P message);
@@ -60,7 +53,9 @@ void serialFlush(void);
  *	@date 07.12.16			first implementation					*/
 static inline void serialWrite(uint8_t data)
 {
+#if SERIAL_ENABLED
 	usartSendData(data);
+#endif
 }
 
 /*! @brief Quick-Init for Serial over USART in RS232 mode
@@ -72,6 +67,8 @@ static inline void serialWrite(uint8_t data)
 static inline void serialInit(usartBaudrate_t baudrate)
 {
 	serialFlush();
+#if SERIAL_ENABLED
 	usartInitRs232(USART_MSTR_ASYNC, baudrate, USART_LEN_8, USART_PARITY_NONE, USART_SBIT_1);
+#endif
 }
 #endif /* SERIAL_H_ */
\ No newline at end of file
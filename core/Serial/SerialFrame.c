@@ -0,0 +1,139 @@
+/*! @brief Channel-multiplexed framing for the serial connection
+ *
+ *	Frames are COBS-encoded while they are being assembled, and sent
+ *	in one piece by serialFrameEnd, so partially built frames never
+ *	reach the wire.
+ *
+ *	@note Not reentrant: frames must not be built from an ISR while
+ *		  the main loop is building one.
+ *
+ *	@author	inselc
+ *	@date	19.10.26	First implementation						*/
+
+/*! @file */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Serial.h"
+#include "SerialFrame.h"
+
+/*	Payload, plus one COBS code byte per started block of 254 bytes	*/
+#define SERIAL_FRAME_BUF_SIZE	(SERIAL_FRAME_MAX_LENGTH + 1 + (SERIAL_FRAME_MAX_LENGTH / 254))
+
+static uint8_t serialFrameBuffer[SERIAL_FRAME_BUF_SIZE];	//!< Encoded frame
+static uint8_t serialFramePosition = 0;		//!< Next write position
+static uint8_t serialFrameCodeIndex = 0;	//!< Code byte of the current block
+static uint8_t serialFrameLength = 0;		//!< Payload bytes in frame
+
+/*! @brief Start assembling a new frame
+ *
+ *	@param[in] channel		Channel the frame belongs to
+ *	@date 19.10.26			first implementation					*/
+void serialFrameBegin(serialChannel_t channel)
+{
+	serialFrameCodeIndex = 0;
+	serialFramePosition = 1;
+	serialFrameLength = 0;
+	serialFramePut(channel);
+}
+
+/*! @brief Append a single payload byte to the current frame
+ *
+ *	@param[in] data			Payload byte
+ *	@date 19.10.26			first implementation					*/
+void serialFramePut(uint8_t data)
+{
+	// Truncate overlong payloads
+	if (serialFrameLength >= SERIAL_FRAME_MAX_LENGTH)
+	{
+		return;
+	}
+	++serialFrameLength;
+
+	if (data == 0x00)
+	{
+		// Close the current block, the zero is implied by its code
+		serialFrameBuffer[serialFrameCodeIndex] = serialFramePosition - serialFrameCodeIndex;
+		serialFrameCodeIndex = serialFramePosition++;
+		return;
+	}
+
+	serialFrameBuffer[serialFramePosition++] = data;
+
+	if (serialFramePosition - serialFrameCodeIndex == 0xFF)
+	{
+		// Maximum block length reached, start a new block
+		serialFrameBuffer[serialFrameCodeIndex] = 0xFF;
+		serialFrameCodeIndex = serialFramePosition++;
+	}
+}
+
+/*! @brief Append a memory buffer to the current frame
+ *
+ *	@param[in] *data		Source data
+ *	@param[in] length		Number of bytes
+ *	@date 19.10.26			first implementation					*/
+void serialFramePutBuf(const uint8_t* data, uint8_t length)
+{
+	if (data == NULL)
+		return;
+
+	for (uint8_t i=0; i < length; ++i)
+	{
+		serialFramePut(data[i]);
+	}
+}
+
+/*! @brief Append a string (without terminator) to the current frame
+ *
+ *	@param[in] *str			String (\0-term.!)
+ *	@date 19.10.26			first implementation					*/
+void serialFramePutStr(const char* str)
+{
+	if (str == NULL)
+		return;
+
+	while (*str != '\0')
+	{
+		serialFramePut(*str++);
+	}
+}
+
+/*! @brief Append a flash string (without terminator) to the current frame
+ *
+ *	@param[in] *str			String in PROGMEM
+ *	@date 19.10.26			first implementation					*/
+void serialFramePutStrP(PGM_P str)
+{
+	char c = (char)pgm_read_byte(str);
+
+	while (c != '\0')
+	{
+		serialFramePut(c);
+		c = (char)pgm_read_byte(++str);
+	}
+}
+
+/*! @brief Finish and transmit the current frame
+ *
+ *	@date 19.10.26			first implementation					*/
+void serialFrameEnd(void)
+{
+	serialFrameBuffer[serialFrameCodeIndex] = serialFramePosition - serialFrameCodeIndex;
+
+	serialWriteBuf(serialFrameBuffer, serialFramePosition, -1);
+	serialWriteChar(SERIAL_FRAME_DELIMITER);
+}
+
+/*! @brief Transmit a complete frame
+ *
+ *	@param[in] channel		Channel the frame belongs to
+ *	@param[in] *data		Payload
+ *	@param[in] length		Payload length
+ *	@date 19.10.26			first implementation					*/
+void serialFrameWrite(serialChannel_t channel, const uint8_t* data, uint8_t length)
+{
+	serialFrameBegin(channel);
+	serialFramePutBuf(data, length);
+	serialFrameEnd();
+}
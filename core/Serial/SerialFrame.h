@@ -0,0 +1,38 @@
+/*! @brief Channel-multiplexed framing for the serial connection
+ *
+ *	Everything the device transmits is wrapped into COBS-encoded
+ *	frames, terminated by a 0x00 delimiter. The first byte of each
+ *	decoded frame selects the channel, so protocol responses and
+ *	log output can share the USART without corrupting each other.
+ *
+ *	@author	inselc
+ *	@date	19.10.26	First implementation						*/
+
+#ifndef SERIALFRAME_H_
+#define SERIALFRAME_H_
+
+/*! @file */
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+#define SERIAL_FRAME_MAX_LENGTH		96		/* Maximum payload incl. channel byte, longer frames are truncated */
+#define SERIAL_FRAME_DELIMITER		0x00
+
+/*!	@enum serialChannel_t
+ *	@brief Frame channel identifiers								*/
+typedef enum {
+	SERIAL_CHANNEL_PROTOCOL = 0x01,		//!< EtheRGB protocol packets
+	SERIAL_CHANNEL_LOG_TEXT = 0x02,		//!< Synchronous log messages
+	SERIAL_CHANNEL_LOG_EVENT = 0x03		//!< Deferred log event records
+} serialChannel_t;
+
+void serialFrameBegin(serialChannel_t channel);
+void serialFramePut(uint8_t data);
+void serialFramePutBuf(const uint8_t* data, uint8_t length);
+void serialFramePutStr(const char* str);
+void serialFramePutStrP(PGM_P str);
+void serialFrameEnd(void);
+void serialFrameWrite(serialChannel_t channel, const uint8_t* data, uint8_t length);
+
+#endif /* SERIALFRAME_H_ */
@@ -28,6 +28,8 @@
 #include "modules/io/io.h"
 #include "modules/spi/spi.h"
 #include "core/Serial/Serial.h"
+#include "core/Serial/SerialFrame.h"
+#include "core/Clock/Clock.h"
 #include "core/Dimmer/Dimmer.h"
 #include "drivers/W5100/W5100.h"
 #include "core/Ethernet/Ethernet.h"
@@ -70,6 +72,10 @@ int main(void)
 	LOG_MESSAGE(SRC_SYSTEM, "Initializing SPI Master...");
 	spiInitMaster(SPI_FOSC_DIV_2, SPI_MODE0, SPI_MSBFIRST);
 
+	// Set up the millisecond system clock
+	LOG_MESSAGE(SRC_SYSTEM, "Initializing system clock...");
+	clockInit();
+
 	// Initialize the Watchdog, in case NIC setup hangs
 	LOG_MESSAGE(SRC_SYSTEM, "Initializing Watchdog Timer...");
 	wdogInit();
@@ -92,6 +98,7 @@ int main(void)
 		staticIP[2] = 178;
 		staticIP[3] = 42;
 	}
+#if LOG_LEVEL_ETHERNET >= LOG_LEVEL_INFO
 	else
 	{
 		char ipStr[4][4];
@@ -99,17 +106,19 @@ int main(void)
 		itoa(staticIP[1], ipStr[1], 10);
 		itoa(staticIP[2], ipStr[2], 10);
 		itoa(staticIP[3], ipStr[3], 10);
-		serialWriteStr(SRC_ETHERNET);
-		serialWriteStr("\tUsing IP address: ");
-		serialWriteStr(ipStr[0]);
-		serialWriteChar('.');
-		serialWriteStr(ipStr[1]);
-		serialWriteChar('.');
-		serialWriteStr(ipStr[2]);
-		serialWriteChar('.');
-		serialWriteStr(ipStr[3]);
-		serialWriteStr("\r\n");
+		serialFrameBegin(SERIAL_CHANNEL_LOG_TEXT);
+		serialFramePutStrP(SRC_ETHERNET);
+		serialFramePutStrP(PSTR("\tUsing IP address: "));
+		serialFramePutStr(ipStr[0]);
+		serialFramePut('.');
+		serialFramePutStr(ipStr[1]);
+		serialFramePut('.');
+		serialFramePutStr(ipStr[2]);
+		serialFramePut('.');
+		serialFramePutStr(ipStr[3]);
+		serialFrameEnd();
 	}
+#endif
 	
 	LOG_MESSAGE(SRC_SYSTEM, "Setting up NIC ...");
  	ethInit((W5100_MSR_1K << W5100_MSR_S0) |	/* Socket 0 TX = 1K */ \
@@ -2,14 +2,30 @@
 # Automatically-generated file. Do not edit or delete the file
 ################################################################################
 
+src\core\Analog\Analog.c
+
+src\core\Clock\Clock.c
+
 src\core\Dimmer\Dimmer.c
 
+src\core\Dimmer\DimmerPCA9685.c
+
+src\core\Dimmer\DimmerPhase.c
+
 src\core\Ethernet\Ethernet.c
 
+src\core\IR\IR.c
+
+src\core\Input\Input.c
+
 src\core\Log\Log.c
 
+src\core\Pixel\Pixel.c
+
 src\core\Serial\Serial.c
 
+src\core\Serial\SerialFrame.c
+
 src\core\Watchdog\Watchdog.c
 
 src\drivers\W5100\W5100.c
@@ -18,8 +34,12 @@ src\main.c
 
 src\modules\spi\spi_master.c
 
+src\modules\twi\twi_master.c
+
 src\services\EtheRGB\EtheRGB.c
 
+src\services\EtheRGB\EtheRGB_Color.c
+
 src\services\EtheRGB\EtheRGB_Command.c
 
 src\services\EtheRGB\EtheRGB_Command_Commands.c
@@ -28,13 +48,23 @@ src\services\EtheRGB\EtheRGB_Command_Responses.c
 
 src\services\EtheRGB\EtheRGB_Config.c
 
+src\services\EtheRGB\EtheRGB_Cue.c
+
 src\services\EtheRGB\EtheRGB_Dimmer.c
 
 src\services\EtheRGB\EtheRGB_Ethernet.c
 
+src\services\EtheRGB\EtheRGB_Group.c
+
 src\services\EtheRGB\EtheRGB_IO.c
 
+src\services\EtheRGB\EtheRGB_Scene.c
+
+src\services\EtheRGB\EtheRGB_Schedule.c
+
 src\services\EtheRGB\EtheRGB_Serial.c
 
 src\services\EtheRGB\EtheRGB_StateMachine.c
 
+src\services\EtheRGB\EtheRGB_Vm.c
+
@@ -0,0 +1,121 @@
+/*!	@brief Analog-to-Digital Converter Definitions
+ *
+ *	@author inselc
+ *	@date 19.10.26		First implementation						*/
+
+#ifndef ADC_H_
+#define ADC_H_
+
+/*!	@file */
+
+#include <stdint.h>
+#include <avr/io.h>
+
+typedef enum {
+	ADC_REF_AREF = 0x00,			//!< External reference at AREF
+	ADC_REF_AVCC = 0x01,			//!< AVcc, with capacitor at AREF
+	ADC_REF_INTERNAL_1V1 = 0x03		//!< Internal 1.1V, with capacitor at AREF
+} adcReference_t;
+
+typedef enum {
+	ADC_CLK_PRESC_DIV_2 = 0x01,		//!< f_adc = f_io / 2
+	ADC_CLK_PRESC_DIV_4 = 0x02,		//!< f_adc = f_io / 4
+	ADC_CLK_PRESC_DIV_8 = 0x03,		//!< f_adc = f_io / 8
+	ADC_CLK_PRESC_DIV_16 = 0x04,	//!< f_adc = f_io / 16
+	ADC_CLK_PRESC_DIV_32 = 0x05,	//!< f_adc = f_io / 32
+	ADC_CLK_PRESC_DIV_64 = 0x06,	//!< f_adc = f_io / 64
+	ADC_CLK_PRESC_DIV_128 = 0x07	//!< f_adc = f_io / 128
+} adcClkPrescaler_t;
+
+/*!	@brief Enable ADC power
+ *
+ *	@date 19.10.26		First implementation						*/
+static inline void adcPowerEnable(void)
+{
+	PRR &= ~(1 << PRADC);
+}
+
+/*!	@brief Disable ADC power
+ *
+ *	@date 19.10.26		First implementation						*/
+static inline void adcPowerDisable(void)
+{
+	PRR |= 1 << PRADC;
+}
+
+/*!	@brief Stop the ADC
+ *
+ *	Disables the ADC, which aborts a running conversion.
+ *
+ *	@date 19.10.26		First implementation						*/
+static inline void adcStop(void)
+{
+	ADCSRA &= ~((1 << ADEN) | (1 << ADATE) | (1 << ADIE));
+}
+
+/*!	@brief Select the voltage reference
+ *
+ *	@param[in] reference	Voltage reference
+ *	@date 19.10.26		First implementation						*/
+static inline void adcSetReference(adcReference_t reference)
+{
+	ADMUX = (ADMUX & 0x3F) | ((reference & 0x03) << REFS0);
+}
+
+/*!	@brief Select the input channel
+ *
+ *	In free running mode, the new channel is used from the
+ *	conversion after the one currently running.
+ *
+ *	@param[in] channel	Input channel (0..8, 14 = 1.1V, 15 = GND)
+ *	@date 19.10.26		First implementation						*/
+static inline void adcSetChannel(uint_fast8_t channel)
+{
+	ADMUX = (ADMUX & 0xF0) | (channel & 0x0F);
+}
+
+/*!	@brief Disable the digital input buffer of an ADC pin
+ *
+ *	@param[in] channel	Input channel (0..5)
+ *	@date 19.10.26		First implementation						*/
+static inline void adcDisableDigitalInput(uint_fast8_t channel)
+{
+	if (channel < 6)
+		DIDR0 |= 1 << channel;
+}
+
+/*!	@brief Initialise the ADC
+ *
+ *	@param[in] reference	Voltage reference
+ *	@date 19.10.26		First implementation						*/
+static inline void adcInit(adcReference_t reference)
+{
+	// Enable power to the ADC
+	adcPowerEnable();
+
+	// Stop any running conversions
+	adcStop();
+
+	// Right-adjusted result
+	ADMUX = 0;
+	adcSetReference(reference);
+
+	// Clear old interrupt (w1r)
+	ADCSRA |= 1 << ADIF;
+}
+
+/*!	@brief Start free running conversions
+ *
+ *	Every completed conversion raises the ADC interrupt.
+ *
+ *	@param[in] prescaler	ADC clock prescaler
+ *	@date 19.10.26		First implementation						*/
+static inline void adcStartFreeRunning(adcClkPrescaler_t prescaler)
+{
+	// Auto trigger source: free running
+	ADCSRB &= ~0x07;
+
+	ADCSRA = (1 << ADEN) | (1 << ADSC) | (1 << ADATE) | (1 << ADIE) | (prescaler & 0x07);
+}
+
+#endif // ADC_H_
@@ -3,7 +3,9 @@
  *	This will include all available timer modules
  *
  *	@author inselc
- *	@date 28.04.17		First implementation						*/
+ *	@date 28.04.17		First implementation
+ *	@date 19.10.26		Added Timer 2
+ *	@date 19.10.26		Added Timer 1								*/
 
 #ifndef TIMER_H_
 #define TIMER_H_
@@ -11,5 +13,7 @@
 /*!	@file */
 
 #include "timer0.h"
+#include "timer1.h"
+#include "timer2.h"
 
 #endif /* TIMER_H_ */
\ No newline at end of file
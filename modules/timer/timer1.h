@@ -0,0 +1,180 @@
+/*!	@brief Timer 1 Definitions
+ *
+ *	@author inselc
+ *	@date 19.10.26		First implementation
+ *	@date 19.10.26		Shared free-running time base				*/
+
+#ifndef TIMER1_H_
+#define TIMER1_H_
+
+/*!	@file */
+
+typedef enum {
+	TMR1_CLK_OFF = 0x00,			//!< Clock off
+	TMR1_CLK_PRESC_DIV_1 = 0x01,	//!< T = T_io
+	TMR1_CLK_PRESC_DIV_8 = 0x02,	//!< T = T_io / 8
+	TMR1_CLK_PRESC_DIV_64 = 0x03,	//!< T = T_io / 64
+	TMR1_CLK_PRESC_DIV_256 = 0x04,	//!< T = T_io / 256
+	TMR1_CLK_PRESC_DIV_1024 = 0x05,	//!< T = T_io / 1024
+	TMR1_CLK_EXT_FALLING = 0x06,	//!< External clock source at T1, falling edge
+	TMR1_CLK_EXT_RISING = 0x07		//!< External clock source at T1, rising edge
+} timer1ClkSrc_t;
+
+typedef enum {
+	TMR1_WG_NORMAL = 0x00,			//!< Normal mode
+	TMR1_WG_PCPWM_8 = 0x01,			//!< Phase-correct PWM, 8 bit
+	TMR1_WG_PCPWM_9 = 0x02,			//!< Phase-correct PWM, 9 bit
+	TMR1_WG_PCPWM_10 = 0x03,		//!< Phase-correct PWM, 10 bit
+	TMR1_WG_CTC = 0x04,				//!< Clear Timer on Compare Match with OCR1A
+	TMR1_WG_FASTPWM_8 = 0x05,		//!< Fast PWM, 8 bit
+	TMR1_WG_FASTPWM_9 = 0x06,		//!< Fast PWM, 9 bit
+	TMR1_WG_FASTPWM_10 = 0x07,		//!< Fast PWM, 10 bit
+	TMR1_WG_CTC_ICR = 0x0C			//!< Clear Timer on Compare Match with ICR1
+} timer1WgMode_t;
+
+typedef enum {
+	TMR1_CAPTURE_FALLING = 0x00,	//!< Capture on falling edge at ICP1
+	TMR1_CAPTURE_RISING = 0x01		//!< Capture on rising edge at ICP1
+} timer1CaptureEdge_t;
+
+/*!	@brief Enable Timer1 power
+ *
+ *	@date 19.10.26		First implementation						*/
+static inline void timer1PowerEnable(void)
+{
+	PRR &= ~(1 << PRTIM1);
+}
+
+/*!	@brief Disable Timer1 power
+ *
+ *	@date 19.10.26		First implementation						*/
+static inline void timer1PowerDisable(void)
+{
+	PRR |= 1 << PRTIM1;
+}
+
+/*!	@brief Stop Timer1
+ *
+ *	@date 19.10.26		First implementation						*/
+static inline void timer1Stop(void)
+{
+	// Clear Clock source configuration bits
+	TCCR1B &= ~(0x07);
+}
+
+/*! @brief Set Timer1 clock source
+ *
+ *	@param[in] src		Clock/Prescaler configuration
+ *	@date 19.10.26		First implementation						*/
+static inline void timer1SetClkSrc(timer1ClkSrc_t src)
+{
+	// Clear current configuration
+	timer1Stop();
+
+	// Apply clock source configuration
+	TCCR1B |= src & 0x07;
+}
+
+/*!	@brief Set Timer1 Waveform Generator mode
+ *
+ *	@param[in] mode		Waveform Generator mode
+ *	@date 19.10.26		First implementation						*/
+static inline void timer1SetWaveGenMode(timer1WgMode_t genMode)
+{
+	// Clear WGM13:0 bits
+	TCCR1A &= ~(0x03);
+	TCCR1B &= ~(0x03 << 3);
+
+	// Apply new configuration
+	TCCR1A |= genMode & 0x03;
+	TCCR1B |= (genMode & 0x0C) << 1;
+}
+
+/*!	@brief Configure the input capture unit
+ *
+ *	@param[in] edge			Edge at ICP1 that triggers a capture
+ *	@param[in] noiseCancel	Require four equal samples before an edge
+ *	@date 19.10.26		First implementation						*/
+static inline void timer1SetCapture(timer1CaptureEdge_t edge, uint8_t noiseCancel)
+{
+	TCCR1B &= ~((1 << ICES1) | (1 << ICNC1));
+	TCCR1B |= (edge << ICES1) | ((noiseCancel ? 1 : 0) << ICNC1);
+}
+
+/*!	@brief Swap the input capture edge
+ *
+ *	The capture flag is cleared, as changing the edge may set it.
+ *
+ *	@date 19.10.26		First implementation						*/
+static inline void timer1ToggleCaptureEdge(void)
+{
+	TCCR1B ^= 1 << ICES1;
+	TIFR1 = 1 << ICF1;
+}
+
+/*!	@brief Set Timer1 Compare Register Value
+ *
+ *	@param[in] value	Compare match value
+ *	@date 19.10.26		First implementation						*/
+static inline void timer1SetCompareA(uint16_t value)
+{
+	OCR1A = value;
+}
+static inline void timer1SetCompareB(uint16_t value)
+{
+	OCR1B = value;
+}
+
+/*!	@brief Initialise Timer1
+ *
+ *	@date 19.10.26		First implementation						*/
+static inline void timer1Init(void)
+{
+	// Enable power to the timer module
+	timer1PowerEnable();
+
+	// Stop any running timers
+	timer1Stop();
+
+	// Disconnect output compare pins
+	TCCR1A = 0;
+
+	// Clear Timer1 interrupt mask
+	TIMSK1 = 0;
+
+	// Clear old Timer1 interrupts (w1r register)
+	TIFR1 = (1 << ICF1) | (1 << OCF1B) | (1 << OCF1A) | (1 << TOV1);
+}
+
+/*!	@brief Start Timer1
+ *
+ *	@param[in] clkSrc	Clock source
+ *	@param[in] genMode	Waveform Generator mode
+ *	@date 19.10.26		First implementation						*/
+static inline void timer1Start(timer1ClkSrc_t clkSrc, timer1WgMode_t genMode)
+{
+	// Configure clock source
+	timer1SetClkSrc(clkSrc);
+
+	// Configure waveform generator mode
+	timer1SetWaveGenMode(genMode);
+}
+
+/*!	@brief Start Timer1 as a free-running time base
+ *
+ *	Timer1 counts at F_CPU / 64 (4us at 16MHz) in normal mode, and
+ *	is shared by the modules timestamping events with it. Only the
+ *	first call sets the timer up; later calls leave the counter and
+ *	the interrupts enabled by other users untouched.
+ *
+ *	@date 19.10.26		First implementation						*/
+static inline void timer1StartFreeRunning(void)
+{
+	if ((TCCR1B & 0x07) == TMR1_CLK_PRESC_DIV_64)
+		return;
+
+	timer1Init();
+	timer1Start(TMR1_CLK_PRESC_DIV_64, TMR1_WG_NORMAL);
+}
+
+#endif // TIMER1_H_
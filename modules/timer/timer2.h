@@ -0,0 +1,132 @@
+/*!	@brief Timer 2 Definitions
+ *
+ *	@author inselc
+ *	@date 19.10.26		First implementation						*/
+
+#ifndef TIMER2_H_
+#define TIMER2_H_
+
+/*!	@file */
+
+typedef enum {
+	TMR2_CLK_OFF = 0x00,			//!< Clock off
+	TMR2_CLK_PRESC_DIV_1 = 0x01,	//!< T = T_io
+	TMR2_CLK_PRESC_DIV_8 = 0x02,	//!< T = T_io / 8
+	TMR2_CLK_PRESC_DIV_32 = 0x03,	//!< T = T_io / 32
+	TMR2_CLK_PRESC_DIV_64 = 0x04,	//!< T = T_io / 64
+	TMR2_CLK_PRESC_DIV_128 = 0x05,	//!< T = T_io / 128
+	TMR2_CLK_PRESC_DIV_256 = 0x06,	//!< T = T_io / 256
+	TMR2_CLK_PRESC_DIV_1024 = 0x07	//!< T = T_io / 1024
+} timer2ClkSrc_t;
+
+typedef enum {
+	TMR2_WG_NORMAL = 0x00,			//!< Normal mode
+	TMR2_WG_PCPWM = 0x01,			//!< Phase-correct PWM
+	TMR2_WG_CTC = 0x02,				//!< Clear Timer on Compare Match
+	TMR2_WG_FASTPWM = 0x03,			//!< Fast PWM
+	TMR2_WG_PCPWM_C = 0x05,			//!< Phase-correct PWM with match at OCRA
+	TMR2_WG_FASTPWM_C = 0x07		//!< Fast PWM with match at OCRA
+} timer2WgMode_t;
+
+/*!	@brief Enable Timer2 power
+ *
+ *	@date 19.10.26		First implementation						*/
+static inline void timer2PowerEnable(void)
+{
+	PRR &= ~(1 << PRTIM2);
+}
+
+/*!	@brief Disable Timer2 power										
+ *
+ *	@date 19.10.26		First implementation						*/
+static inline void timer2PowerDisable(void)
+{
+	PRR |= 1 << PRTIM2;
+}
+
+/*!	@brief Stop Timer2
+ *
+ *	@date 19.10.26		First implementation						*/
+static inline void timer2Stop(void)
+{
+	// Clear Clock source configuration bits
+	TCCR2B &= ~(0x07);
+}
+
+/*! @brief Set Timer2 clock source
+ *
+ *	@param[in] src		Clock/Prescaler configuration
+ *	@date 19.10.26		First implementation						*/
+static inline void timer2SetClkSrc(timer2ClkSrc_t src)
+{
+	// Clear current configuration
+	timer2Stop();
+
+	// Apply clock source configuration
+	TCCR2B |= src & 0x07;
+}
+
+/*!	@brief Set Timer2 Waveform Generator mode
+ *
+ *	@param[in] mode		Waveform Generator mode
+ *	@date 19.10.26		First implementation						*/
+static inline void timer2SetWaveGenMode(timer2WgMode_t genMode)
+{
+	// Clear WGM22:0 bits
+	TCCR2A &= ~(0x03);
+	TCCR2B &= ~(1 << 3);
+
+	// Apply new configuration
+	TCCR2A |= genMode & 0x03;
+	TCCR2B |= (genMode & 0x04) << 1;
+}
+
+/*!	@brief Set Timer2 Compare Register Value
+ *
+ *	@param[in] value	Compare match value
+ *	@date 19.10.26		First implementation						*/
+static inline void timer2SetCompareA(uint_fast8_t value)
+{
+	OCR2A = value;
+}
+static inline void timer2SetCompareB(uint_fast8_t value)
+{
+	OCR2B = value;
+}
+
+/*!	@brief Initialise Timer2
+ *
+ *	@date 19.10.26		First implementation						*/
+static inline void timer2Init(void)
+{
+	// Enable power to the timer module
+	timer2PowerEnable();
+
+	// Stop any running timers
+	timer2Stop();
+
+	// Clock from the I/O clock, not from TOSC1
+	ASSR = 0;
+
+	// Clear Timer2 interrupt mask
+	TIMSK2 = 0;
+
+	// Clear old Timer2 interrupts (w1r register)
+	TIFR2 = 0x07;
+}
+
+/*!	@brief Start Timer2
+ *
+ *	@param[in] clkSrc	Clock source
+ *	@param[in] genMode	Waveform Generator mode
+ *	@date 19.10.26		First implementation						*/
+static inline void timer2Start(timer2ClkSrc_t clkSrc, timer2WgMode_t genMode)
+{
+	// Configure clock source
+	timer2SetClkSrc(clkSrc);
+	
+	// Configure waveform generator mode
+	timer2SetWaveGenMode(genMode);
+}
+
+#endif // TIMER2_H_
@@ -0,0 +1,16 @@
+/*! @brief Top-level TWI (I2C) header file
+ *
+ *	@author	inselc
+ *	@date	19.10.26	initial version								*/
+
+#ifndef TWI_H_
+#define TWI_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <avr/io.h>
+
+#include "twi_common.h"
+#include "twi_master.h"
+
+#endif /* TWI_H_ */
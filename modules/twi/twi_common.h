@@ -0,0 +1,94 @@
+/*! @brief Common TWI (I2C) definitions
+ *
+ *	@author	inselc
+ *	@date	19.10.26	initial version								*/
+
+#ifndef TWI_COMMON_H_
+#define TWI_COMMON_H_
+
+/*! @file */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <avr/io.h>
+
+/*!	@enum twiStatus_t
+ *	Master transmitter status codes (TWSR, prescaler bits masked)
+ *	See datasheet p. 227 (Table 22-3 Status codes for Master
+ *	Transmitter Mode).												*/
+typedef enum tagTwiStatus_t {
+	TWI_STATUS_START		= 0x08,		//!< START transmitted
+	TWI_STATUS_REP_START	= 0x10,		//!< Repeated START transmitted
+	TWI_STATUS_SLA_W_ACK	= 0x18,		//!< SLA+W transmitted, ACK received
+	TWI_STATUS_SLA_W_NACK	= 0x20,		//!< SLA+W transmitted, NACK received
+	TWI_STATUS_DATA_ACK		= 0x28,		//!< Data transmitted, ACK received
+	TWI_STATUS_DATA_NACK	= 0x30,		//!< Data transmitted, NACK received
+	TWI_STATUS_ARB_LOST		= 0x38		//!< Arbitration lost
+} twiStatus_t;
+
+/*! @brief Enable power to the TWI module
+ *
+ *	@date 19.10.26				first implementation				*/
+static inline void twiPowerEnable(void)
+{
+	PRR &= ~(1 << PRTWI);
+}
+
+/*! @brief Disable power to the TWI module
+ *
+ *	@date 19.10.26				first implementation				*/
+static inline void twiPowerDisable(void)
+{
+	PRR |= 1 << PRTWI;
+}
+
+/*! @brief Set the SCL frequency
+ *
+ *	f_scl = f_io / (16 + 2 * TWBR), prescaler 1.
+ *
+ *	@param[in] bitrate			Bit rate register value
+ *	@date 19.10.26				first implementation				*/
+static inline void twiSetBitrate(uint8_t bitrate)
+{
+	TWSR &= ~((1 << TWPS1) | (1 << TWPS0));
+	TWBR = bitrate;
+}
+
+/*! @brief Get the bus status of the last operation
+ *
+ *	@return uint8_t				Status code (twiStatus_t)
+ *	@date 19.10.26				first implementation				*/
+static inline uint8_t twiGetStatus(void)
+{
+	return TWSR & 0xF8;
+}
+
+/*! @brief Transmit a START condition, interrupt when done
+ *
+ *	@date 19.10.26				first implementation				*/
+static inline void twiSendStart(void)
+{
+	TWCR = (1 << TWINT) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE);
+}
+
+/*! @brief Transmit a data byte, interrupt when done
+ *
+ *	@param[in] data				Data or SLA+R/W byte
+ *	@date 19.10.26				first implementation				*/
+static inline void twiSendData(uint8_t data)
+{
+	TWDR = data;
+	TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+}
+
+/*! @brief Transmit a STOP condition
+ *
+ *	The hardware clears TWSTO once the STOP has been sent.
+ *
+ *	@date 19.10.26				first implementation				*/
+static inline void twiSendStop(void)
+{
+	TWCR = (1 << TWINT) | (1 << TWSTO) | (1 << TWEN);
+}
+
+#endif /* TWI_COMMON_H_ */
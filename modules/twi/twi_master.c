@@ -0,0 +1,144 @@
+/*! @brief Interrupt-driven TWI (I2C) Master transmitter
+ *
+ *	A write transfer is started by twiMasterWrite and completed by the
+ *	TWI interrupt, one byte per interrupt. The data buffer must stay
+ *	unchanged until twiMasterIsBusy returns false.
+ *
+ *	@author	inselc
+ *	@date	19.10.26	initial version
+ *	@date	19.10.26	last transfer status						*/
+
+#include <stddef.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "twi_master.h"
+
+static volatile bool twiBusy = false;						//!< Transfer in progress
+static uint8_t twiAddress;									//!< SLA+W of the current transfer
+static const uint8_t* twiData = NULL;						//!< Data of the current transfer
+static uint8_t twiLength = 0;								//!< Number of data bytes
+static volatile uint8_t twiIndex = 0;						//!< Next data byte
+static volatile uint8_t twiErrorCount = 0;					//!< Failed transfers (saturating)
+static volatile bool twiFailed = false;						//!< Last transfer failed
+
+/*! @brief Initialise TWI in Master mode
+ *
+ *	Enables the internal pull-ups on SDA (PC4) and SCL (PC5); add
+ *	external pull-ups for longer buses or 400kHz.
+ *
+ *	@param[in] clkRate		SCL clock rate
+ *	@date 19.10.26			first implementation					*/
+void twiInitMaster(twiClkRate_t clkRate)
+{
+	// Enable TWI module power
+	twiPowerEnable();
+
+	// SDA and SCL as inputs with pull-up
+	DDRC &= ~((1 << 4) | (1 << 5));
+	PORTC |= (1 << 4) | (1 << 5);
+
+	twiSetBitrate(clkRate);
+
+	twiBusy = false;
+	TWCR = 1 << TWEN;
+}
+
+/*! @brief Start a write transfer
+ *
+ *	@param[in] address		7 bit slave address
+ *	@param[in] *data		Data bytes, kept until the transfer ends
+ *	@param[in] length		Number of data bytes
+ *	@return bool			false, if another transfer is in progress
+ *	@date 19.10.26			first implementation
+ *	@date 19.10.26			clear the failure flag					*/
+bool twiMasterWrite(uint8_t address, const uint8_t* data, uint8_t length)
+{
+	if (twiBusy)
+		return false;
+
+	// STOP of the previous transfer still pending
+	while (TWCR & (1 << TWSTO)) {;}
+
+	twiAddress = (uint8_t)(address << 1);
+	twiData = data;
+	twiLength = length;
+	twiIndex = 0;
+	twiFailed = false;
+	twiBusy = true;
+	twiSendStart();
+	return true;
+}
+
+/*! @brief Check for a transfer in progress
+ *
+ *	@return bool			true, while a transfer is in progress
+ *	@date 19.10.26			first implementation					*/
+bool twiMasterIsBusy(void)
+{
+	return twiBusy;
+}
+
+/*! @brief Check, if the last transfer failed
+ *
+ *	@return bool			true, if the last transfer ended with an
+ *							error; false while it is in progress
+ *	@date 19.10.26			first implementation					*/
+bool twiMasterHasFailed(void)
+{
+	return twiFailed;
+}
+
+/*! @brief Get the number of failed transfers
+ *
+ *	@return uint8_t			Failed transfers, saturates at 255
+ *	@date 19.10.26			first implementation					*/
+uint8_t twiMasterGetErrorCount(void)
+{
+	return twiErrorCount;
+}
+
+// -----------------------------------------------------------------
+
+/*! @brief TWI ISR: master transmitter state machine
+ *
+ *	@date 19.10.26			first implementation
+ *	@date 19.10.26			last transfer status					*/
+ISR(TWI_vect)
+{
+	switch (twiGetStatus())
+	{
+	case TWI_STATUS_START:
+	case TWI_STATUS_REP_START:
+		twiSendData(twiAddress);
+		break;
+
+	case TWI_STATUS_SLA_W_ACK:
+	case TWI_STATUS_DATA_ACK:
+		if (twiIndex < twiLength)
+		{
+			twiSendData(twiData[twiIndex++]);
+			break;
+		}
+		twiSendStop();
+		twiBusy = false;
+		break;
+
+	case TWI_STATUS_ARB_LOST:
+		// Bus released by hardware, no STOP
+		TWCR = 1 << TWEN;
+		if (twiErrorCount < 0xFF)
+			++twiErrorCount;
+		twiFailed = true;
+		twiBusy = false;
+		break;
+
+	default:
+		// NACK or bus error
+		twiSendStop();
+		if (twiErrorCount < 0xFF)
+			++twiErrorCount;
+		twiFailed = true;
+		twiBusy = false;
+		break;
+	}
+}
@@ -0,0 +1,36 @@
+/*! @brief Interrupt-driven TWI (I2C) Master transmitter
+ *
+ *	@author	inselc
+ *	@date	19.10.26	initial version
+ *	@date	19.10.26	last transfer status						*/
+
+#ifndef TWI_MASTER_H_
+#define TWI_MASTER_H_
+
+/*! @file */
+
+#include "twi_common.h"
+
+/*!	@enum twiClkRate_t
+ *	TWBR values for common SCL frequencies at 16MHz					*/
+typedef enum tagTwiClkRate_t
+{
+	TWI_16M_100K = 72,
+	TWI_16M_400K = 12
+} twiClkRate_t;
+
+void twiInitMaster(twiClkRate_t clkRate);
+bool twiMasterWrite(uint8_t address, const uint8_t* data, uint8_t length);
+bool twiMasterIsBusy(void);
+bool twiMasterHasFailed(void);
+uint8_t twiMasterGetErrorCount(void);
+
+/*! @brief Wait for the current transfer to finish
+ *
+ *	@date 19.10.26			first implementation					*/
+static inline void twiMasterWait(void)
+{
+	while (twiMasterIsBusy()) {;}
+}
+
+#endif /* TWI_MASTER_H_ */
@@ -0,0 +1,73 @@
+/*! @brief Master SPI mode (MSPIM) specific USART definitions
+ *
+ *	In MSPIM mode the USART drives a clock at XCK (PD4) and shifts
+ *	data out at TXD (PD1), independent of the SPI module.
+ *
+ *	@author	inselc
+ *	@date	19.10.26	initial version								*/
+
+#ifndef USART_SPI_H_
+#define USART_SPI_H_
+
+#include "usart_common.h"
+
+/*! @file */
+
+/*! @enum usartSpiMode_t
+ *	Clock polarity and phase, as for the SPI module					*/
+typedef enum tagUsartSpiMode_t
+{
+	USART_SPI_MODE0 = 0x00,			//!< Sample on rising edge, idle low
+	USART_SPI_MODE1 = 0x01,			//!< Sample on falling edge, idle low
+	USART_SPI_MODE2 = 0x02,			//!< Sample on falling edge, idle high
+	USART_SPI_MODE3 = 0x03			//!< Sample on rising edge, idle high
+} usartSpiMode_t;
+
+/*! @brief Setup USART in master SPI mode, transmit only
+ *
+ *	See datasheet p. 254 (25.4 USART MSPIM Initialization).
+ *
+ *	@param[in] mode				Clock polarity and phase
+ *	@param[in] lsbFirst			Shift out the least significant bit first
+ *	@param[in] ubrr				Baud rate register, f_xck = f_io / (2 * (ubrr + 1))
+ *	@date 19.10.26				first implementation				*/
+static inline void usartInitSpiMaster(usartSpiMode_t mode, bool lsbFirst, uint16_t ubrr)
+{
+	// Enable USART module power
+	usartPowerEnable();
+
+	// Baud rate register must be zero while enabling the transmitter
+	UBRR0 = 0;
+
+	// XCK is the clock output
+	DDRD |= 1 << PD4;
+
+	UCSR0C = (1 << UMSEL01) | (1 << UMSEL00) | ((lsbFirst ? 1 : 0) << UDORD0) |
+		((mode & 0x01) << UCPHA0) | (((mode & 0x02) >> 1) << UCPOL0);
+	UCSR0B = 1 << TXEN0;
+
+	UBRR0 = ubrr;
+}
+
+/*! @brief Wait until all data has been shifted out
+ *
+ *	@date 19.10.26				first implementation				*/
+static inline void usartSpiWaitComplete(void)
+{
+	while (!(UCSR0A & (1 << TXC0))) {;}
+	UCSR0A |= 1 << TXC0;
+}
+
+/*! @brief Shift out a single byte
+ *
+ *	Waits for the transmit buffer, not for the transfer to finish.
+ *
+ *	@param[in] data				Data byte
+ *	@date 19.10.26				first implementation				*/
+static inline void usartSpiWrite(uint8_t data)
+{
+	usartWaitDREmpty();
+	UDR0 = data;
+}
+
+#endif /* USART_SPI_H_ */
@@ -6,16 +6,31 @@
  *	@date 21.05.17			First implementation
  *	@date 25.06.17			Added command module
  *	@date 08.07.17			Reworked comms module
- *	@date 11.07.17			Restructuring							*/
+ *	@date 11.07.17			Restructuring
+ *	@date 19.10.26			Dimmer first, it owns the output pins
+ *	@date 19.10.26			Pixel strip output
+ *	@date 19.10.26			Scenes
+ *	@date 19.10.26			Cue lists
+ *	@date 19.10.26			Effect VM
+ *	@date 19.10.26			HSV color fades
+ *	@date 19.10.26			Channel groups
+ *	@date 19.10.26			Scheduled commands						*/
 
 #include <stdio.h>
 #include <stdint.h>
 #include "../../core/Serial/Serial.h"
 #include "../../core/Log/Log.h"
 #include "../../core/Ethernet/Ethernet.h"
+#include "../../core/Pixel/Pixel.h"
 #include "EtheRGB_Command.h"
 #include "EtheRGB_Dimmer.h"
+#include "EtheRGB_Color.h"
+#include "EtheRGB_Group.h"
 #include "EtheRGB_IO.h"
+#include "EtheRGB_Scene.h"
+#include "EtheRGB_Cue.h"
+#include "EtheRGB_Vm.h"
+#include "EtheRGB_Schedule.h"
 #include "EtheRGB_Serial.h"
 #include "EtheRGB_Ethernet.h"
 #include "EtheRGB_StateMachine.h"
@@ -31,16 +46,25 @@ static etheRgbCommand_t SharedResponseBuffer = {ETHERGB_INVALID_COMMAND, SharedR
  *	@param[in] port			Server port								*/
 void etheRgbInit(socket_t socket, uint16_t port)
 {
+	etheRgbDimmer_Init();
+	etheRgbGroup_Init();
+	pixelInit();
+	etheRgbScene_Init();
+	etheRgbCue_Init();
+	etheRgbVm_Init();
 	etheRgbIO_Init(&SharedCommandBuffer);
+	etheRgbSchedule_Init(&SharedCommandBuffer);
 	etheRgbSerial_Init(&SharedCommandBuffer);
 	etheRgbEthernet_Init(&SharedCommandBuffer, socket, port);
 	etheRgbStateMachine_Init(&SharedCommandBuffer, &SharedResponseBuffer);
 	etheRgbCommand_Init(&SharedCommandBuffer, &SharedResponseBuffer);
-	etheRgbDimmer_Init();
 }
 
 void etheRgbPoll(void)
 {
 	etheRgbStateMachine_Poll();
+	etheRgbCue_Poll();
+	etheRgbVm_Poll();
+	etheRgbColor_Poll();
 	etheRgbDimmer_Poll();
 }
\ No newline at end of file
@@ -0,0 +1,435 @@
+/*!	@brief EtheRGB Color module
+ *
+ *	All conversions use 8 bit fixed point math, with the hardware
+ *	multiplier and without divisions; only RGB to HSV divides, once
+ *	per command. Color temperatures are interpolated from a table in
+ *	program memory.
+ *
+ *	A fixture set by HSV keeps its color in a slot, so it can fade on
+ *	from there in HSV space - a hue rotation is a single command. Fades
+ *	are interpolated from the elapsed time on the millisecond clock,
+ *	like the dimmer's crossfade. A slot is given up as soon as one of
+ *	its channels is set or faded otherwise. With all slots in use, a
+ *	new fixture takes over the least recently used slot not fading;
+ *	the fixture that loses it starts from its RGB values next time.
+ *
+ *	@author	inselc
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Reuse idle slots						*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <avr/pgmspace.h>
+#include "../../core/Clock/Clock.h"
+#include "EtheRGB_Dimmer.h"
+#include "EtheRGB_Color.h"
+
+#define COLOR_SLOT_FREE			0xFF	/* Channel of an unused slot */
+#define COLOR_CCT_ENTRIES		((ETHERGB_COLOR_CCT_MAX - ETHERGB_COLOR_CCT_MIN) / ETHERGB_COLOR_CCT_STEP + 1)
+
+/*!	@brief Color temperatures, from ETHERGB_COLOR_CCT_MIN in steps of
+ *	       ETHERGB_COLOR_CCT_STEP, as red, green, blue					*/
+static const uint8_t ColorCctTable[COLOR_CCT_ENTRIES][3] PROGMEM = {
+	{ 255,  68,   0 },	// 1000K
+	{ 255, 108,   0 },	// 1500K
+	{ 255, 137,  14 },	// 2000K
+	{ 255, 159,  70 },	// 2500K
+	{ 255, 177, 110 },	// 3000K
+	{ 255, 193, 141 },	// 3500K
+	{ 255, 206, 166 },	// 4000K
+	{ 255, 218, 187 },	// 4500K
+	{ 255, 228, 206 },	// 5000K
+	{ 255, 237, 222 },	// 5500K
+	{ 255, 246, 237 },	// 6000K
+	{ 255, 254, 250 },	// 6500K
+	{ 243, 242, 255 },	// 7000K
+	{ 230, 235, 255 },	// 7500K
+	{ 221, 230, 255 },	// 8000K
+	{ 215, 226, 255 },	// 8500K
+	{ 210, 223, 255 },	// 9000K
+	{ 205, 220, 255 },	// 9500K
+	{ 202, 218, 255 },	// 10000K
+	{ 199, 216, 255 },	// 10500K
+	{ 196, 214, 255 },	// 11000K
+	{ 193, 213, 255 },	// 11500K
+	{ 191, 211, 255 }	// 12000K
+};
+
+/*!	@brief HSV color of a fixture									*/
+typedef struct {
+	uint8_t channel;				//!< First channel, or COLOR_SLOT_FREE
+	uint8_t rgb[3];					//!< Values last written
+	uint16_t hue;					//!< Hue, in 1/256 hue steps
+	uint8_t saturation;				//!< Saturation
+	uint8_t value;					//!< Value
+	bool fading;					//!< A fade is running
+	uint16_t startHue;				//!< Hue at the start of the fade
+	int32_t hueDistance;			//!< Hue change of the fade, signed
+	uint8_t startSaturation;		//!< Saturation at the start of the fade
+	uint8_t targetSaturation;		//!< Saturation at the end of the fade
+	uint8_t startValue;				//!< Value at the start of the fade
+	uint8_t targetValue;			//!< Value at the end of the fade
+	uint32_t startTime;				//!< Start of the fade, in ms
+	uint16_t duration;				//!< Duration of the fade, in ms
+	uint32_t lastUsed;				//!< Last set or fade, in ms
+} etheRgbColorSlot_t;
+
+static etheRgbColorSlot_t ColorSlots[ETHERGB_COLOR_SLOTS] = {
+	[0 ... ETHERGB_COLOR_SLOTS - 1] = { .channel = COLOR_SLOT_FREE }
+};
+static uint32_t ColorLastPoll = 0;		//!< Time of the last fade step, in ms
+
+/*!	@brief Scale a value by a fraction
+ *
+ *	@param[in] value		Value
+ *	@param[in] scale		Fraction, 255 = 1.0
+ *	@return uint8_t			Scaled value
+ *	@date 19.10.26			First implementation					*/
+static inline uint8_t etheRgbColor_Scale(uint8_t value, uint8_t scale)
+{
+	return ((uint16_t)value * (scale + 1)) >> 8;
+}
+
+/*!	@brief Interpolate between two values
+ *
+ *	@param[in] start		Value at progress 0
+ *	@param[in] target		Value at progress 0x100
+ *	@param[in] progress		Progress, in 1/256
+ *	@return uint8_t			Interpolated value
+ *	@date 19.10.26			First implementation					*/
+static inline uint8_t etheRgbColor_Interpolate(uint8_t start, uint8_t target, uint16_t progress)
+{
+	return (target >= start) ?
+		start + (uint8_t)(((uint16_t)(target - start) * progress) >> 8) :
+		start - (uint8_t)(((uint16_t)(start - target) * progress) >> 8);
+}
+
+/*!	@brief Convert HSV to RGB
+ *
+ *	@param[in] hue			Hue, 0..255 for 0..360 degrees
+ *	@param[in] saturation	Saturation
+ *	@param[in] value		Value
+ *	@param[out] *rgb		Red, green, blue
+ *	@date 19.10.26			First implementation					*/
+void etheRgbColor_HsvToRgb(uint8_t hue, uint8_t saturation, uint8_t value, uint8_t* rgb)
+{
+	// Six sectors of 256 steps
+	uint16_t position = (uint16_t)hue * 6;
+	uint8_t sector = position >> 8;
+	uint8_t fraction = position & 0xFF;
+
+	uint8_t p = etheRgbColor_Scale(value, 0xFF - saturation);
+	uint8_t q = etheRgbColor_Scale(value, 0xFF - etheRgbColor_Scale(saturation, fraction));
+	uint8_t t = etheRgbColor_Scale(value, 0xFF - etheRgbColor_Scale(saturation, 0xFF - fraction));
+
+	switch (sector)
+	{
+		case 0:		rgb[0] = value;	rgb[1] = t;		rgb[2] = p;		break;
+		case 1:		rgb[0] = q;		rgb[1] = value;	rgb[2] = p;		break;
+		case 2:		rgb[0] = p;		rgb[1] = value;	rgb[2] = t;		break;
+		case 3:		rgb[0] = p;		rgb[1] = q;		rgb[2] = value;	break;
+		case 4:		rgb[0] = t;		rgb[1] = p;		rgb[2] = value;	break;
+		default:	rgb[0] = value;	rgb[1] = p;		rgb[2] = q;		break;
+	}
+}
+
+/*!	@brief Convert RGB to HSV
+ *
+ *	@param[in] *rgb			Red, green, blue
+ *	@param[out] *hsv		Hue, saturation, value
+ *	@date 19.10.26			First implementation					*/
+void etheRgbColor_RgbToHsv(const uint8_t* rgb, uint8_t* hsv)
+{
+	uint8_t max = rgb[0];
+	uint8_t min = rgb[0];
+	for (uint8_t i = 1; i < 3; ++i)
+	{
+		if (rgb[i] > max)
+			max = rgb[i];
+		if (rgb[i] < min)
+			min = rgb[i];
+	}
+
+	uint8_t delta = max - min;
+	hsv[2] = max;
+	if (delta == 0)
+	{
+		hsv[0] = 0;
+		hsv[1] = 0;
+		return;
+	}
+	hsv[1] = ((uint16_t)delta * 0xFF) / max;
+
+	// Position in six sectors of 256 steps
+	int16_t position;
+	if (max == rgb[0])
+		position = (int16_t)(((int32_t)(rgb[1] - rgb[2]) << 8) / delta);
+	else if (max == rgb[1])
+		position = 0x200 + (int16_t)(((int32_t)(rgb[2] - rgb[0]) << 8) / delta);
+	else
+		position = 0x400 + (int16_t)(((int32_t)(rgb[0] - rgb[1]) << 8) / delta);
+	if (position < 0)
+		position += 0x600;
+
+	hsv[0] = position / 6;
+}
+
+/*!	@brief Convert a color temperature to RGB
+ *
+ *	@param[in] kelvin		Color temperature in K, clamped to
+ *							ETHERGB_COLOR_CCT_MIN..ETHERGB_COLOR_CCT_MAX
+ *	@param[in] intensity	Intensity
+ *	@param[out] *rgb		Red, green, blue
+ *	@date 19.10.26			First implementation					*/
+void etheRgbColor_CctToRgb(uint16_t kelvin, uint8_t intensity, uint8_t* rgb)
+{
+	if (kelvin < ETHERGB_COLOR_CCT_MIN)
+		kelvin = ETHERGB_COLOR_CCT_MIN;
+	else if (kelvin > ETHERGB_COLOR_CCT_MAX)
+		kelvin = ETHERGB_COLOR_CCT_MAX;
+
+	uint16_t offset = kelvin - ETHERGB_COLOR_CCT_MIN;
+	uint8_t index = offset / ETHERGB_COLOR_CCT_STEP;
+	uint16_t progress = ((offset % ETHERGB_COLOR_CCT_STEP) << 8) / ETHERGB_COLOR_CCT_STEP;
+	uint8_t next = (index < COLOR_CCT_ENTRIES - 1) ? index + 1 : index;
+
+	for (uint8_t i = 0; i < 3; ++i)
+	{
+		uint8_t value = etheRgbColor_Interpolate(pgm_read_byte(&ColorCctTable[index][i]),
+			pgm_read_byte(&ColorCctTable[next][i]), progress);
+		rgb[i] = etheRgbColor_Scale(value, intensity);
+	}
+}
+
+/*!	@brief Check whether a slot's channels still show its color
+ *
+ *	@param[in] *slot		Slot
+ *	@return bool			false, if a channel has been set or faded
+ *							otherwise
+ *	@date 19.10.26			First implementation					*/
+static bool etheRgbColor_IsOwned(const etheRgbColorSlot_t* slot)
+{
+	for (uint8_t i = 0; i < 3; ++i)
+	{
+		if ((etheRgbDimmer_GetChannelValue(slot->channel + i) != slot->rgb[i])
+			|| etheRgbDimmer_IsChannelFading(slot->channel + i))
+			return false;
+	}
+	return true;
+}
+
+/*!	@brief Write a slot's color to its channels
+ *
+ *	@param[in] *slot		Slot
+ *	@date 19.10.26			First implementation					*/
+static void etheRgbColor_Write(etheRgbColorSlot_t* slot)
+{
+	uint8_t rgb[3];
+	etheRgbColor_HsvToRgb(slot->hue >> 8, slot->saturation, slot->value, rgb);
+
+	for (uint8_t i = 0; i < 3; ++i)
+	{
+		if (rgb[i] != slot->rgb[i])
+		{
+			etheRgbDimmer_SetChannelValue(slot->channel + i, rgb[i]);
+			slot->rgb[i] = rgb[i];
+		}
+	}
+}
+
+/*!	@brief Get the slot of a fixture
+ *
+ *	Takes a free slot if the fixture has none, or else the least
+ *	recently used slot that is not fading.
+ *
+ *	@param[in] channel		First channel of the fixture
+ *	@return etheRgbColorSlot_t*	Slot, NULL if all are fading
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Reuse idle slots						*/
+static etheRgbColorSlot_t* etheRgbColor_GetSlot(uint8_t channel)
+{
+	uint32_t now = clockMillis();
+	etheRgbColorSlot_t* free = NULL;
+	etheRgbColorSlot_t* idle = NULL;
+	for (uint8_t i = 0; i < ETHERGB_COLOR_SLOTS; ++i)
+	{
+		etheRgbColorSlot_t* slot = &ColorSlots[i];
+		if ((slot->channel != COLOR_SLOT_FREE) && !etheRgbColor_IsOwned(slot))
+			slot->channel = COLOR_SLOT_FREE;
+
+		if (slot->channel == channel)
+		{
+			slot->lastUsed = now;
+			return slot;
+		}
+		if ((slot->channel == COLOR_SLOT_FREE) && (free == NULL))
+			free = slot;
+		if ((slot->channel != COLOR_SLOT_FREE) && !slot->fading &&
+			((idle == NULL) || (now - slot->lastUsed > now - idle->lastUsed)))
+			idle = slot;
+	}
+
+	if (free == NULL)
+		free = idle;
+
+	if (free != NULL)
+	{
+		// Start from the fixture's current color
+		free->channel = channel;
+		free->fading = false;
+		free->lastUsed = now;
+		for (uint8_t i = 0; i < 3; ++i)
+		{
+			free->rgb[i] = etheRgbDimmer_GetChannelValue(channel + i);
+		}
+		uint8_t hsv[3];
+		etheRgbColor_RgbToHsv(free->rgb, hsv);
+		free->hue = (uint16_t)hsv[0] << 8;
+		free->saturation = hsv[1];
+		free->value = hsv[2];
+	}
+	return free;
+}
+
+/*!	@brief Release the slot of a fixture, if any
+ *
+ *	@param[in] channel		First channel of the fixture
+ *	@date 19.10.26			First implementation					*/
+static void etheRgbColor_ReleaseSlot(uint8_t channel)
+{
+	for (uint8_t i = 0; i < ETHERGB_COLOR_SLOTS; ++i)
+	{
+		if (ColorSlots[i].channel == channel)
+			ColorSlots[i].channel = COLOR_SLOT_FREE;
+	}
+}
+
+/*!	@brief Color fade polling routine
+ *
+ *	Steps the fades at most once per millisecond.
+ *
+ *	@date 19.10.26			First implementation					*/
+void etheRgbColor_Poll(void)
+{
+	uint32_t now = clockMillis();
+	if (now == ColorLastPoll)
+		return;
+	ColorLastPoll = now;
+
+	for (uint8_t i = 0; i < ETHERGB_COLOR_SLOTS; ++i)
+	{
+		etheRgbColorSlot_t* slot = &ColorSlots[i];
+		if ((slot->channel == COLOR_SLOT_FREE) || !slot->fading)
+			continue;
+
+		if (!etheRgbColor_IsOwned(slot))
+		{
+			slot->channel = COLOR_SLOT_FREE;
+			continue;
+		}
+
+		uint32_t elapsed = now - slot->startTime;
+		bool done = (elapsed >= slot->duration);
+		uint16_t progress = done ? 0x100 : (uint16_t)((elapsed << 8) / slot->duration);
+
+		slot->hue = slot->startHue + (uint16_t)((slot->hueDistance * progress) >> 8);
+		slot->saturation = etheRgbColor_Interpolate(slot->startSaturation, slot->targetSaturation, progress);
+		slot->value = etheRgbColor_Interpolate(slot->startValue, slot->targetValue, progress);
+		etheRgbColor_Write(slot);
+
+		if (done)
+			slot->fading = false;
+	}
+}
+
+/*!	@brief Set a fixture's color by HSV
+ *
+ *	@param[in] channel		First of the fixture's R, G, B channels
+ *	@param[in] hue			Hue, 0..255 for 0..360 degrees
+ *	@param[in] saturation	Saturation
+ *	@param[in] value		Value
+ *	@return bool			false, if the channels are out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbColor_SetHsv(uint8_t channel, uint8_t hue, uint8_t saturation, uint8_t value)
+{
+	uint8_t hsv[3] = { hue, saturation, value };
+	return etheRgbColor_FadeHsv(channel, hsv, 0, 0);
+}
+
+/*!	@brief Set a fixture's color by color temperature
+ *
+ *	@param[in] channel		First of the fixture's R, G, B channels
+ *	@param[in] kelvin		Color temperature, in K
+ *	@param[in] intensity	Intensity
+ *	@return bool			false, if the channels are out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbColor_SetCct(uint8_t channel, uint16_t kelvin, uint8_t intensity)
+{
+	if (channel > ETHERGB_MAX_OUTPUT_PINS - 3)
+		return false;
+
+	uint8_t rgb[3];
+	etheRgbColor_CctToRgb(kelvin, intensity, rgb);
+	etheRgbColor_ReleaseSlot(channel);
+	for (uint8_t i = 0; i < 3; ++i)
+	{
+		etheRgbDimmer_SetChannelValue(channel + i, rgb[i]);
+	}
+	return true;
+}
+
+/*!	@brief Fade a fixture to an HSV color
+ *
+ *	The hue takes the shorter way round, unless turns are given: then
+ *	it moves in their direction, with as many full turns on top.
+ *
+ *	@param[in] channel		First of the fixture's R, G, B channels
+ *	@param[in] *hsv			Target hue, saturation, value
+ *	@param[in] duration		Duration in ms, 0 to set the color at once
+ *	@param[in] turns		Full hue turns, negative for decreasing
+ *							hue, 0 for the shorter way
+ *	@return bool			false, if the channels are out of bounds or
+ *							all slots are fading
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbColor_FadeHsv(uint8_t channel, const uint8_t* hsv, uint16_t duration, int8_t turns)
+{
+	if (channel > ETHERGB_MAX_OUTPUT_PINS - 3)
+		return false;
+
+	etheRgbColorSlot_t* slot = etheRgbColor_GetSlot(channel);
+	if (slot == NULL)
+		return false;
+
+	// Shorter way round, or the way of the turns plus the turns
+	if (turns < -127)
+		turns = -127;
+	int16_t distance = (int16_t)(((uint16_t)hsv[0] << 8) - slot->hue);
+	int32_t hueDistance = distance;
+	if ((turns > 0) && (distance < 0))
+		hueDistance += 0x10000;
+	else if ((turns < 0) && (distance > 0))
+		hueDistance -= 0x10000;
+	hueDistance += (int32_t)turns << 16;
+
+	slot->startHue = slot->hue;
+	slot->hueDistance = hueDistance;
+	slot->startSaturation = slot->saturation;
+	slot->targetSaturation = hsv[1];
+	slot->startValue = slot->value;
+	slot->targetValue = hsv[2];
+	slot->startTime = clockMillis();
+	slot->duration = duration;
+	slot->fading = true;
+
+	if (duration == 0)
+	{
+		// Complete right away
+		slot->hue = (uint16_t)hsv[0] << 8;
+		slot->saturation = hsv[1];
+		slot->value = hsv[2];
+		slot->fading = false;
+		etheRgbColor_Write(slot);
+	}
+	return true;
+}
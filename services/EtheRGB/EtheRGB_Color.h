@@ -0,0 +1,30 @@
+/*!	@brief EtheRGB Color module
+ *
+ *	Converts HSV and color temperatures to RGB channel values, and
+ *	fades fixtures (three consecutive R/G/B channels) in HSV space.
+ *
+ *	@author	inselc
+ *	@date 19.10.26			First implementation					*/
+
+#ifndef ETHERGB_COLOR_H_
+#define ETHERGB_COLOR_H_
+
+/*!	@file */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ETHERGB_COLOR_SLOTS			4		/* Fixtures with an HSV color or fade */
+#define ETHERGB_COLOR_CCT_MIN		1000	/* Lowest color temperature, in K */
+#define ETHERGB_COLOR_CCT_MAX		12000	/* Highest color temperature, in K */
+#define ETHERGB_COLOR_CCT_STEP		500		/* Color temperature table step, in K */
+
+void etheRgbColor_HsvToRgb(uint8_t hue, uint8_t saturation, uint8_t value, uint8_t* rgb);
+void etheRgbColor_RgbToHsv(const uint8_t* rgb, uint8_t* hsv);
+void etheRgbColor_CctToRgb(uint16_t kelvin, uint8_t intensity, uint8_t* rgb);
+void etheRgbColor_Poll(void);
+bool etheRgbColor_SetHsv(uint8_t channel, uint8_t hue, uint8_t saturation, uint8_t value);
+bool etheRgbColor_SetCct(uint8_t channel, uint16_t kelvin, uint8_t intensity);
+bool etheRgbColor_FadeHsv(uint8_t channel, const uint8_t* hsv, uint16_t duration, int8_t turns);
+
+#endif /* ETHERGB_COLOR_H_ */
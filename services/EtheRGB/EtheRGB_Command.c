@@ -7,17 +7,32 @@
  *	@date 11.07.17			Restructuring
  *	@date 15.07.17			Added new commands
  *	@date 18.07.17			Added new commands
- *	@date 23.07.17			Added new commands						*/
+ *	@date 23.07.17			Added new commands
+ *	@date 19.10.26			Added IO mapping commands
+ *	@date 19.10.26			Added pixel commands
+ *	@date 19.10.26			Added scene commands
+ *	@date 19.10.26			Added cue list commands
+ *	@date 19.10.26			Added effect VM commands
+ *	@date 19.10.26			Added HSV and CCT commands
+ *	@date 19.10.26			Added channel group commands
+ *	@date 19.10.26			Added master level command
+ *	@date 19.10.26			Added schedule commands
+ *	@date 19.10.26			Command map in flash					*/
 
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <avr/pgmspace.h>
 #include "../../core/Serial/Serial.h"
 #include "../../core/Log/Log.h"
 #include "../../tools/ArrayTools.h"
 #include "EtheRGB_Command.h"
 #include "EtheRGB_Command_Commands.h"
 #include "EtheRGB_Command_Responses.h"
+#include "EtheRGB_IO.h"
+#include "EtheRGB_Vm.h"
+#include "EtheRGB_Group.h"
+#include "EtheRGB_Schedule.h"
 
 // Commands will return true if data needs to be sent back
 typedef struct __attribute__((packed)) {
@@ -35,12 +50,67 @@ static etheRgbCommand_t* SharedResponseBuffer = NULL;
  *	@date 11.07.17			Restructuring
  *	@date 15.07.17			Added single channel commands
  *	@date 18.07.17			Added GroupColor commands
- *	@date 23.07.17			Added SetIP and Reboot					*/
-static const etheRgbCommandMap_t AVAILABLE_COMMANDS[] = {
+ *	@date 23.07.17			Added SetIP and Reboot
+ *	@date 19.10.26			Added IO mapping commands
+ *	@date 19.10.26			Added pixel commands
+ *	@date 19.10.26			Added scene commands
+ *	@date 19.10.26			Added cue list commands
+ *	@date 19.10.26			Added effect VM commands
+ *	@date 19.10.26			Added HSV and CCT commands
+ *	@date 19.10.26			Added channel group commands
+ *	@date 19.10.26			Added master level command
+ *	@date 19.10.26			Added schedule commands
+ *	@date 19.10.26			Command map in flash					*/
+static const etheRgbCommandMap_t AVAILABLE_COMMANDS[] PROGMEM = {
 	{ (uint8_t)'t', 0, Command_Test },
 	{ 0x01, 2, Command_SetChannelValue },
 	{ 0x02, 3, Command_FadeChannelValue },
 	{ 0x03, 4, Command_SetGroupColor },
+	{ 0x04, 3 + ETHERGB_PIXEL_DATA_LENGTH, Command_SetPixels },
+	{ 0x05, 8, Command_FillPixels },
+	{ 0x06, 2, Command_GetPixel },
+	{ 0x07, 4, Command_SetGroupHsv },
+	{ 0x08, 4, Command_SetGroupCct },
+	{ 0x09, 7, Command_FadeGroupHsv },
+	{ 0x0A, 1 + GROUP_ROLE_COUNT, Command_SetGroupChannels },
+	{ 0x0B, 1, Command_GetGroupChannels },
+	{ 0x0C, 1 + GROUP_ROLE_COUNT, Command_SetGroup },
+	{ 0x0D, 2 + GROUP_ROLE_COUNT, Command_FadeGroup },
+	{ 0x0E, 2, Command_SetGroupLevel },
+	{ 0x0F, 3, Command_SetMaster },
+	{ 0x10, 5, Command_SetIoPin },
+	{ 0x11, 4 + ETHERGB_IO_MAX_DATA_LENGTH, Command_SetIoCommand },
+	{ 0x12, 3, Command_SetIoRamp },
+	{ 0x13, 1, Command_GetIoPin },
+	{ 0x14, 2, Command_GetIoCommand },
+	{ 0x15, 7, Command_SetIoEncoder },
+	{ 0x16, 1, Command_GetIoEncoder },
+	{ 0x17, 4, Command_SetIoAnalog },
+	{ 0x18, 1, Command_GetIoAnalog },
+	{ 0x19, 8 + ETHERGB_IO_MAX_DATA_LENGTH, Command_SetIrKey },
+	{ 0x1A, 1, Command_GetIrKey },
+	{ 0x1B, 0, Command_GetIrCode },
+	{ 0x1C, 3, Command_SetOutputPin },
+	{ 0x1D, 1, Command_GetOutputPin },
+	{ 0x1F, 0, Command_SaveIoConfig },
+	{ 0x20, 1, Command_StoreScene },
+	{ 0x21, 3, Command_RecallScene },
+	{ 0x22, 2, Command_GetScene },
+	{ 0x28, 7, Command_SetCue },
+	{ 0x29, 1, Command_GetCue },
+	{ 0x2A, 1, Command_StartCues },
+	{ 0x2B, 0, Command_StopCues },
+	{ 0x2C, 0, Command_GoCue },
+	{ 0x2D, 0, Command_GetCueState },
+	{ 0x30, 2 + ETHERGB_VM_DATA_LENGTH, Command_WriteVmProgram },
+	{ 0x31, 0, Command_StartVm },
+	{ 0x32, 0, Command_StopVm },
+	{ 0x33, 0, Command_GetVmState },
+	{ 0x34, 3, Command_SetVmRegister },
+	{ 0x40, 6 + ETHERGB_SCHEDULE_DATA_LENGTH, Command_ScheduleCommand },
+	{ 0x41, 0, Command_GetClock },
+	{ 0x42, 4, Command_SetClock },
+	{ 0x43, 0, Command_ClearSchedule },
 	{ 0xF0, 4, Command_SetIpAddress },
 	{ 0xFE, 0, Command_Reboot }
 };
@@ -62,12 +132,13 @@ void etheRgbCommand_Init(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* resp
  *	@param[in] commandType	Value to search for
  *	@return	bool			true, if list contains command type		
  *	@date 08.07.17			First implementation
- *	@date 11.07.17			Rework									*/
+ *	@date 11.07.17			Rework
+ *	@date 19.10.26			Command map in flash					*/
 bool etheRgbCommand_HasCommand(uint8_t commandType)
 {
 	for (int i=0; i < LENGTHOF(AVAILABLE_COMMANDS); ++i)
 	{
-		if (AVAILABLE_COMMANDS[i].command == commandType)
+		if (pgm_read_byte(&AVAILABLE_COMMANDS[i].command) == commandType)
 		{
 			// Found command
 			return true;
@@ -84,14 +155,15 @@ bool etheRgbCommand_HasCommand(uint8_t commandType)
  *
  *	@param[in] commandType	Command type to look for
  *	@return uint8_t			Data length for command type, or 0
- *	@date 11.07.17			First implementation					*/
+ *	@date 11.07.17			First implementation
+ *	@date 19.10.26			Command map in flash					*/
 uint8_t etheRgbCommand_GetRequiredDataLength(uint8_t commandType)
 {
 	for (int i=0; i < LENGTHOF(AVAILABLE_COMMANDS); ++i)
 	{
-		if (AVAILABLE_COMMANDS[i].command == commandType)
+		if (pgm_read_byte(&AVAILABLE_COMMANDS[i].command) == commandType)
 		{
-			return AVAILABLE_COMMANDS[i].requiredDataLength;
+			return pgm_read_byte(&AVAILABLE_COMMANDS[i].requiredDataLength);
 		}
 	}
 
@@ -102,18 +174,15 @@ uint8_t etheRgbCommand_GetRequiredDataLength(uint8_t commandType)
  *
  *	@param[in] data			Source data
  *	@return uint8_t			Even parity								
- *	@date 11.07.17			First implementation					*/
+ *	@date 11.07.17			First implementation
+ *	@date 19.10.26			Fold instead of looping over all bits	*/
 uint8_t etheRgbCommand_CalculateEvenParity(uint8_t data)
 {
-	uint8_t parity = 0;
-	
-	for (int i=0; i < 8; ++i)
-	{
-		if (data & (1 << i))
-			parity ^= 0x01;
-	}
+	data ^= data >> 4;
+	data ^= data >> 2;
+	data ^= data >> 1;
 
-	return parity;
+	return data & 0x01;
 }
 
 /*!	@brief Calculate the checksum for a command or response packet
@@ -146,7 +215,8 @@ uint8_t etheRgbCommand_CalculateChecksum(etheRgbCommand_t* command)
  *
  *	@return bool			
  *	@date 08.07.17			First implementation
- *	@date 11.07.17			Rework									*/
+ *	@date 11.07.17			Rework
+ *	@date 19.10.26			Command map in flash					*/
 bool etheRgbCommand_Run(void)
 {
 	if (SharedCommandBuffer == NULL || SharedResponseBuffer == NULL)
@@ -156,16 +226,17 @@ bool etheRgbCommand_Run(void)
 
 	for (int i=0; i < LENGTHOF(AVAILABLE_COMMANDS); ++i)
 	{
-		if (AVAILABLE_COMMANDS[i].command == SharedCommandBuffer->commandType)
+		if (pgm_read_byte(&AVAILABLE_COMMANDS[i].command) == SharedCommandBuffer->commandType)
 		{
-			if (AVAILABLE_COMMANDS[i].function == NULL)
+			etheRgbCommandFunc_t function = (etheRgbCommandFunc_t)pgm_read_ptr(&AVAILABLE_COMMANDS[i].function);
+			if (function == NULL)
 			{
 				LOG_ERROR(SRC_ETHERGB, "Command function ptr is NULL.");
 				return false;
 			}
 			
 			// Run command function
-			return AVAILABLE_COMMANDS[i].function(SharedCommandBuffer, SharedResponseBuffer);
+			return function(SharedCommandBuffer, SharedResponseBuffer);
 		}
 	}
 
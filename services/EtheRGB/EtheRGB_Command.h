@@ -4,7 +4,10 @@
  *
  *	@author	inselc
  *	@date 08.07.17			First implementation
- *	@date 11.07.17			Restructuring					*/
+ *	@date 11.07.17			Restructuring
+ *	@date 19.10.26			Longer packets for configuration
+ *	@date 19.10.26			Pixel data length
+ *	@date 19.10.26			Scheduled commands					*/
 
 #ifndef ETHERGB_COMMAND_H_
 #define ETHERGB_COMMAND_H_
@@ -13,7 +16,8 @@
 
 #include <stdint.h>
 
-#define ETHERGB_MAX_DATA_LENGTH	8
+#define ETHERGB_MAX_DATA_LENGTH	16
+#define ETHERGB_PIXEL_DATA_LENGTH	12	/* Color bytes per SetPixels command, 4 RGB or 3 RGBW pixels */
 #define ETHERGB_START_BYTE (uint8_t)'A'
 #define ETHERGB_INVALID_COMMAND (uint8_t)0x00
 
@@ -21,7 +25,8 @@ typedef enum uint8_t {
 	SOURCE_NONE,
 	SOURCE_SERIAL,
 	SOURCE_ETHERNET,
-	SOURCE_IO
+	SOURCE_IO,
+	SOURCE_SCHEDULE
 } etheRgbSource_t;
 
 /*!	@brief Command structure containing command and 
@@ -38,6 +43,7 @@ typedef struct __attribute__((packed)) {
 void etheRgbCommand_Init(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
 bool etheRgbCommand_HasCommand(uint8_t commandType);
 uint8_t etheRgbCommand_GetRequiredDataLength(uint8_t commandType);
+uint8_t etheRgbCommand_CalculateEvenParity(uint8_t data);
 uint8_t etheRgbCommand_CalculateChecksum(etheRgbCommand_t* command);
 bool etheRgbCommand_Run(void);
 
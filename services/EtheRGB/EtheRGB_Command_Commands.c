@@ -5,7 +5,16 @@
  *	@date 13.07.17			Moved from EtheRGB_Command
  *	@date 15.07.17			Added Single channel commands
  *	@date 18.07.17			Added GroupColor commands
- *	@date 23.07.17			Added SetIP and Reboot					*/
+ *	@date 23.07.17			Added SetIP and Reboot
+ *	@date 19.10.26			Added IO mapping commands
+ *	@date 19.10.26			Added pixel commands
+ *	@date 19.10.26			Added scene commands
+ *	@date 19.10.26			Added cue list commands
+ *	@date 19.10.26			Added effect VM commands
+ *	@date 19.10.26			Added HSV and CCT commands
+ *	@date 19.10.26			Added channel group commands
+ *	@date 19.10.26			Added master level command
+ *	@date 19.10.26			Added schedule commands					*/
 
 #include <stdio.h>
 #include <stdint.h>
@@ -13,10 +22,18 @@
 #include "../../core/Serial/Serial.h"
 #include "../../core/Log/Log.h"
 #include "../../core/Watchdog/Watchdog.h"
+#include "../../core/Pixel/Pixel.h"
 #include "EtheRGB_Command.h"
 #include "EtheRGB_Command_Commands.h"
 #include "EtheRGB_Command_Responses.h"
 #include "EtheRGB_Dimmer.h"
+#include "EtheRGB_Color.h"
+#include "EtheRGB_Group.h"
+#include "EtheRGB_IO.h"
+#include "EtheRGB_Scene.h"
+#include "EtheRGB_Cue.h"
+#include "EtheRGB_Vm.h"
+#include "EtheRGB_Schedule.h"
 #include "EtheRGB_Config.h"
 
 /*!	@brief Test command
@@ -27,7 +44,7 @@
  *	@date 13.07.17			First implementation					*/
 bool Command_Test(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
 {
-	LOG_MESSAGE(SRC_ETHERGB, "-- Test command received! --");
+	LOG_EVENT(SRC_ETHERGB, LOG_EVT_CMD_TEST, commandBuffer->source);
 	etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_OK);
 	return true;
 }
@@ -64,12 +81,13 @@ bool Command_FadeChannelValue(etheRgbCommand_t* commandBuffer, etheRgbCommand_t*
  *	Set a group's color without fading
  *
  *	@return bool			true
- *	@date 18.07.17			First implementation					*/
+ *	@date 18.07.17			First implementation
+ *	@date 19.10.26			Accept the last three channels			*/
 bool Command_SetGroupColor(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
 {
-	if (commandBuffer->data[0] >= (ETHERGB_MAX_OUTPUT_PINS - 3))
+	if (commandBuffer->data[0] > (ETHERGB_MAX_OUTPUT_PINS - 3))
 	{
-		LOG_ERROR(SRC_ETHERGB, "Group start out of range");
+		LOG_EVENT(SRC_ETHERGB, LOG_EVT_CMD_GROUP_OUT_OF_RANGE, commandBuffer->data[0]);
 		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
 		return true;
 	}
@@ -81,6 +99,261 @@ bool Command_SetGroupColor(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* re
 	return true;
 }
 
+/*!	@brief Set the colors of consecutive pixels
+ *
+ *	Data: first pixel (2 bytes, MSB first), number of pixels, colors
+ *	(red, green, blue, and white for RGBW strips), up to
+ *	ETHERGB_PIXEL_DATA_LENGTH bytes
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_SetPixels(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	uint16_t index = ((uint16_t)commandBuffer->data[0] << 8) | commandBuffer->data[1];
+	uint8_t count = commandBuffer->data[2];
+
+	if ((count == 0) || (count > ETHERGB_PIXEL_DATA_LENGTH / PIXEL_BYTES))
+	{
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	bool result = true;
+	for (uint8_t i = 0; i < count; ++i)
+	{
+		result = result && pixelSet(index + i, &commandBuffer->data[3 + i * PIXEL_BYTES]);
+	}
+	etheRgbCommand_SetStatusResponse(responseBuffer, result ? STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Set a range of pixels to one color
+ *
+ *	Data: first pixel, number of pixels (2 bytes each, MSB first),
+ *	red, green, blue, white (ignored for RGB strips)
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_FillPixels(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	uint16_t index = ((uint16_t)commandBuffer->data[0] << 8) | commandBuffer->data[1];
+	uint16_t count = ((uint16_t)commandBuffer->data[2] << 8) | commandBuffer->data[3];
+
+	etheRgbCommand_SetStatusResponse(responseBuffer,
+		pixelFill(index, count, &commandBuffer->data[4]) ? STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Read a pixel's color
+ *
+ *	Response data: pixel (2 bytes, MSB first), red, green, blue, and
+ *	white for RGBW strips
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_GetPixel(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	uint8_t data[2 + PIXEL_BYTES];
+	data[0] = commandBuffer->data[0];
+	data[1] = commandBuffer->data[1];
+
+	if (!pixelGet(((uint16_t)data[0] << 8) | data[1], &data[2]))
+	{
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	etheRgbCommand_SetDataResponse(responseBuffer, data, sizeof(data));
+	return true;
+}
+
+/*!	@brief Log why an HSV command failed
+ *
+ *	@param[in] channel		Group start
+ *	@date 19.10.26			First implementation					*/
+static void Command_LogColorError(uint8_t channel)
+{
+	if (channel > ETHERGB_MAX_OUTPUT_PINS - 3)
+		LOG_EVENT(SRC_ETHERGB, LOG_EVT_CMD_GROUP_OUT_OF_RANGE, channel);
+	else
+		LOG_EVENT(SRC_ETHERGB, LOG_EVT_CMD_COLOR_SLOTS_BUSY, channel);
+}
+
+/*!	@brief Set an RGB channel group's color by HSV
+ *
+ *	Data: group start, hue (0..255 for 0..360 degrees), saturation,
+ *	value
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Log the cause of a failure				*/
+bool Command_SetGroupHsv(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	if (!etheRgbColor_SetHsv(commandBuffer->data[0], commandBuffer->data[1], commandBuffer->data[2], commandBuffer->data[3]))
+	{
+		Command_LogColorError(commandBuffer->data[0]);
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_OK);
+	return true;
+}
+
+/*!	@brief Set an RGB channel group's color by color temperature
+ *
+ *	Data: group start, color temperature in K (2 bytes, MSB first),
+ *	intensity
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_SetGroupCct(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	uint16_t kelvin = ((uint16_t)commandBuffer->data[1] << 8) | commandBuffer->data[2];
+
+	if (!etheRgbColor_SetCct(commandBuffer->data[0], kelvin, commandBuffer->data[3]))
+	{
+		LOG_EVENT(SRC_ETHERGB, LOG_EVT_CMD_GROUP_OUT_OF_RANGE, commandBuffer->data[0]);
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_OK);
+	return true;
+}
+
+/*!	@brief Fade an RGB channel group to an HSV color, in HSV space
+ *
+ *	Data: group start, hue, saturation, value, duration in ms (2 bytes,
+ *	MSB first), hue turns (signed, 0 for the shorter way)
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Log failures							*/
+bool Command_FadeGroupHsv(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	uint16_t duration = ((uint16_t)commandBuffer->data[4] << 8) | commandBuffer->data[5];
+
+	if (!etheRgbColor_FadeHsv(commandBuffer->data[0], &commandBuffer->data[1], duration, (int8_t)commandBuffer->data[6]))
+	{
+		Command_LogColorError(commandBuffer->data[0]);
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_OK);
+	return true;
+}
+
+/*!	@brief Map channels to a group's roles
+ *
+ *	Data: group, channels for red, green, blue, white, intensity
+ *	(0xFF for none)
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_SetGroupChannels(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbGroupChannels_t channels;
+	for (uint8_t role = 0; role < GROUP_ROLE_COUNT; ++role)
+	{
+		channels.channels[role] = commandBuffer->data[1 + role];
+	}
+
+	etheRgbCommand_SetStatusResponse(responseBuffer,
+		etheRgbGroup_SetChannels(commandBuffer->data[0], &channels) ? STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Read a group's channel mapping
+ *
+ *	Data: group
+ *	Response data: as for SetGroupChannels
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_GetGroupChannels(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	uint8_t data[1 + GROUP_ROLE_COUNT];
+	data[0] = commandBuffer->data[0];
+
+	if (!etheRgbGroup_GetChannels(data[0], (etheRgbGroupChannels_t*)&data[1]))
+	{
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	etheRgbCommand_SetDataResponse(responseBuffer, data, sizeof(data));
+	return true;
+}
+
+/*!	@brief Set a group's values without fading
+ *
+ *	Data: group, red, green, blue, white, intensity
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_SetGroup(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	if (!etheRgbGroup_Set(commandBuffer->data[0], &commandBuffer->data[1]))
+	{
+		LOG_EVENT(SRC_ETHERGB, LOG_EVT_CMD_GROUP_OUT_OF_RANGE, commandBuffer->data[0]);
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_OK);
+	return true;
+}
+
+/*!	@brief Fade a group to new values
+ *
+ *	Data: group, speed, red, green, blue, white, intensity
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_FadeGroup(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	if (!etheRgbGroup_Fade(commandBuffer->data[0], &commandBuffer->data[2], commandBuffer->data[1]))
+	{
+		LOG_EVENT(SRC_ETHERGB, LOG_EVT_CMD_GROUP_OUT_OF_RANGE, commandBuffer->data[0]);
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_OK);
+	return true;
+}
+
+/*!	@brief Set a group's submaster level
+ *
+ *	Data: group, level
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_SetGroupLevel(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbCommand_SetStatusResponse(responseBuffer,
+		etheRgbGroup_SetLevel(commandBuffer->data[0], commandBuffer->data[1]) ? STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Set or fade the master level of all channels
+ *
+ *	Data: level (0 for blackout), fade duration in ms (2 bytes, MSB
+ *	first)
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_SetMaster(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	uint16_t duration = ((uint16_t)commandBuffer->data[1] << 8) | commandBuffer->data[2];
+
+	etheRgbDimmer_SetMaster(commandBuffer->data[0], duration);
+	etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_OK);
+	return true;
+}
+
 /*!	@brief Save a new IP Address to EEPROM
  *
  *	Writes a new static IP to the device's internal EEPROM.
@@ -133,6 +406,687 @@ bool Command_SetIpAddress(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* res
 	return true;
 }
 
+/*!	@brief Set an IO mapping's pin and trigger
+ *
+ *	Data: index, port (0=B, 1=C, 2=D, 0xFF=unused), pin number,
+ *	flags, trigger. Commands and ramp of the entry are kept.
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_SetIoPin(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbIoConfig_t config;
+
+	if (!etheRgbIO_GetConfig(commandBuffer->data[0], &config))
+	{
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	config.port = commandBuffer->data[1];
+	config.number = commandBuffer->data[2];
+	config.flags = commandBuffer->data[3];
+	config.trigger = commandBuffer->data[4];
+
+	etheRgbCommand_SetStatusResponse(responseBuffer,
+		etheRgbIO_SetConfig(commandBuffer->data[0], &config) ? STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Set an IO mapping's command for one gesture
+ *
+ *	Data: index, gesture (0 for edge and level triggers), command,
+ *	data length, command data. Command 0 clears the slot.
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_SetIoCommand(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbIoConfig_t config;
+	uint8_t gesture = commandBuffer->data[1];
+
+	if ((gesture >= ETHERGB_IO_GESTURE_COUNT) ||
+		(commandBuffer->data[3] > ETHERGB_IO_MAX_DATA_LENGTH) ||
+		(commandBuffer->dataLength < 4 + commandBuffer->data[3]) ||
+		!etheRgbIO_GetConfig(commandBuffer->data[0], &config))
+	{
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	config.commands[gesture].command = commandBuffer->data[2];
+	config.commands[gesture].dataLength = commandBuffer->data[3];
+	for (uint8_t i = 0; i < ETHERGB_IO_MAX_DATA_LENGTH; ++i)
+	{
+		config.commands[gesture].data[i] = (i < commandBuffer->data[3]) ? commandBuffer->data[4 + i] : 0x00;
+	}
+
+	etheRgbCommand_SetStatusResponse(responseBuffer,
+		etheRgbIO_SetConfig(commandBuffer->data[0], &config) ? STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Set the channels an IO mapping ramps while held
+ *
+ *	Data: index, channel bit mask, fading speed
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_SetIoRamp(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	if (commandBuffer->data[0] >= ETHERGB_MAX_COMMAND_PINS)
+	{
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	etheRgbIO_SetupRamp(commandBuffer->data[0], commandBuffer->data[1], commandBuffer->data[2]);
+	etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_OK);
+	return true;
+}
+
+/*!	@brief Read an IO mapping's pin, trigger and ramp
+ *
+ *	Response data: index, port, pin number, flags, trigger, ramp
+ *	channel mask, ramp speed
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_GetIoPin(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbIoConfig_t config;
+
+	if (!etheRgbIO_GetConfig(commandBuffer->data[0], &config))
+	{
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	uint8_t data[7] = {
+		commandBuffer->data[0],
+		config.port,
+		config.number,
+		config.flags,
+		config.trigger,
+		config.rampChannels,
+		config.rampSpeed
+	};
+	etheRgbCommand_SetDataResponse(responseBuffer, data, sizeof(data));
+	return true;
+}
+
+/*!	@brief Read an IO mapping's command for one gesture
+ *
+ *	Response data: index, gesture, command, data length, command data
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_GetIoCommand(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbIoConfig_t config;
+	uint8_t gesture = commandBuffer->data[1];
+
+	if ((gesture >= ETHERGB_IO_GESTURE_COUNT) || !etheRgbIO_GetConfig(commandBuffer->data[0], &config))
+	{
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	uint8_t data[4 + ETHERGB_IO_MAX_DATA_LENGTH];
+	data[0] = commandBuffer->data[0];
+	data[1] = gesture;
+	data[2] = config.commands[gesture].command;
+	data[3] = config.commands[gesture].dataLength;
+	for (uint8_t i = 0; i < ETHERGB_IO_MAX_DATA_LENGTH; ++i)
+	{
+		data[4 + i] = config.commands[gesture].data[i];
+	}
+	etheRgbCommand_SetDataResponse(responseBuffer, data, sizeof(data));
+	return true;
+}
+
+/*!	@brief Set a rotary encoder mapping
+ *
+ *	Data: index, port (0xFF=unused), pin A, pin B, flags, channel
+ *	bit mask, brightness step per detent
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_SetIoEncoder(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbIoEncoderConfig_t config = {
+		.port = commandBuffer->data[1],
+		.numberA = commandBuffer->data[2],
+		.numberB = commandBuffer->data[3],
+		.flags = commandBuffer->data[4],
+		.channels = commandBuffer->data[5],
+		.stepSize = commandBuffer->data[6]
+	};
+
+	etheRgbCommand_SetStatusResponse(responseBuffer,
+		etheRgbIO_SetEncoderConfig(commandBuffer->data[0], &config) ? STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Read a rotary encoder mapping
+ *
+ *	Response data: index, port, pin A, pin B, flags, channel bit
+ *	mask, brightness step per detent
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_GetIoEncoder(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbIoEncoderConfig_t config;
+
+	if (!etheRgbIO_GetEncoderConfig(commandBuffer->data[0], &config))
+	{
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	uint8_t data[7] = {
+		commandBuffer->data[0],
+		config.port,
+		config.numberA,
+		config.numberB,
+		config.flags,
+		config.channels,
+		config.stepSize
+	};
+	etheRgbCommand_SetDataResponse(responseBuffer, data, sizeof(data));
+	return true;
+}
+
+/*!	@brief Set an analog input mapping
+ *
+ *	Data: index, ADC channel (0xFF=unused), flags, channel bit mask
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_SetIoAnalog(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbIoAnalogConfig_t config = {
+		.input = commandBuffer->data[1],
+		.flags = commandBuffer->data[2],
+		.channels = commandBuffer->data[3]
+	};
+
+	etheRgbCommand_SetStatusResponse(responseBuffer,
+		etheRgbIO_SetAnalogConfig(commandBuffer->data[0], &config) ? STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Read an analog input mapping
+ *
+ *	Response data: index, ADC channel, flags, channel bit mask
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_GetIoAnalog(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbIoAnalogConfig_t config;
+
+	if (!etheRgbIO_GetAnalogConfig(commandBuffer->data[0], &config))
+	{
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	uint8_t data[4] = {
+		commandBuffer->data[0],
+		config.input,
+		config.flags,
+		config.channels
+	};
+	etheRgbCommand_SetDataResponse(responseBuffer, data, sizeof(data));
+	return true;
+}
+
+/*!	@brief Set an infrared remote key mapping
+ *
+ *	Data: index, protocol (0=unused), address (2 bytes, MSB first),
+ *	key code, flags, command, data length, command data
+ *
+ *	Takes effect immediately, key mappings are not held in RAM.
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_SetIrKey(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbIoIrKey_t key = {
+		.protocol = commandBuffer->data[1],
+		.address = ((uint16_t)commandBuffer->data[2] << 8) | commandBuffer->data[3],
+		.code = commandBuffer->data[4],
+		.flags = commandBuffer->data[5],
+		.command.command = commandBuffer->data[6],
+		.command.dataLength = commandBuffer->data[7]
+	};
+	for (uint8_t i = 0; i < ETHERGB_IO_MAX_DATA_LENGTH; ++i)
+	{
+		key.command.data[i] = commandBuffer->data[8 + i];
+	}
+
+	etheRgbCommand_SetStatusResponse(responseBuffer,
+		etheRgbIO_SetIrKey(commandBuffer->data[0], &key) ? STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Read an infrared remote key mapping
+ *
+ *	Response data: index, protocol, address (2 bytes, MSB first),
+ *	key code, flags, command, data length, command data
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_GetIrKey(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbIoIrKey_t key;
+
+	if (!etheRgbIO_GetIrKey(commandBuffer->data[0], &key))
+	{
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	uint8_t data[8 + ETHERGB_IO_MAX_DATA_LENGTH];
+	data[0] = commandBuffer->data[0];
+	data[1] = key.protocol;
+	data[2] = key.address >> 8;
+	data[3] = key.address;
+	data[4] = key.code;
+	data[5] = key.flags;
+	data[6] = key.command.command;
+	data[7] = key.command.dataLength;
+	for (uint8_t i = 0; i < ETHERGB_IO_MAX_DATA_LENGTH; ++i)
+	{
+		data[8 + i] = key.command.data[i];
+	}
+	etheRgbCommand_SetDataResponse(responseBuffer, data, sizeof(data));
+	return true;
+}
+
+/*!	@brief Read the last received infrared key code
+ *
+ *	Used to learn the codes of a remote before mapping its keys.
+ *	Response data: protocol, address (2 bytes, MSB first), key code,
+ *	repeat flag
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_GetIrCode(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	irCode_t code;
+
+	if (!etheRgbIO_GetLastIrCode(&code))
+	{
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	uint8_t data[5] = {
+		code.protocol,
+		code.address >> 8,
+		code.address,
+		code.command,
+		code.repeat
+	};
+	etheRgbCommand_SetDataResponse(responseBuffer, data, sizeof(data));
+	return true;
+}
+
+/*!	@brief Assign an output pin to a channel
+ *
+ *	Data: channel, port (0xFF=none), pin number
+ *
+ *	Takes effect immediately and is stored in EEPROM.
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_SetOutputPin(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbDimmerPin_t pin = {
+		.port = commandBuffer->data[1],
+		.number = commandBuffer->data[2]
+	};
+
+	etheRgbCommand_SetStatusResponse(responseBuffer,
+		etheRgbDimmer_SetOutputPin(commandBuffer->data[0], &pin) ? STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Read a channel's output pin
+ *
+ *	Response data: channel, port, pin number
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_GetOutputPin(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbDimmerPin_t pin;
+
+	if (!etheRgbDimmer_GetOutputPin(commandBuffer->data[0], &pin))
+	{
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	uint8_t data[3] = {
+		commandBuffer->data[0],
+		pin.port,
+		pin.number
+	};
+	etheRgbCommand_SetDataResponse(responseBuffer, data, sizeof(data));
+	return true;
+}
+
+/*!	@brief Store the IO, encoder and analog input mappings in EEPROM
+ *
+ *	The stored mappings are loaded at boot.
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_SaveIoConfig(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbIO_SaveConfig();
+	etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_OK);
+	return true;
+}
+
+/*!	@brief Store the current channel values as a scene
+ *
+ *	Data: scene
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_StoreScene(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbCommand_SetStatusResponse(responseBuffer,
+		etheRgbScene_Store(commandBuffer->data[0]) ? STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Recall a scene, crossfading all channels
+ *
+ *	Data: scene, crossfade duration in ms (2 bytes, MSB first, 0 to
+ *	set the values at once)
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_RecallScene(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	uint16_t duration = ((uint16_t)commandBuffer->data[1] << 8) | commandBuffer->data[2];
+
+	etheRgbCommand_SetStatusResponse(responseBuffer,
+		etheRgbScene_Recall(commandBuffer->data[0], duration) ? STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Read a scene's channel values
+ *
+ *	Data: scene, first channel
+ *	Response data: scene, first channel, values of up to
+ *	ETHERGB_MAX_DATA_LENGTH - 2 channels
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_GetScene(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	uint8_t values[ETHERGB_MAX_OUTPUT_PINS];
+	uint8_t first = commandBuffer->data[1];
+
+	if ((first >= ETHERGB_MAX_OUTPUT_PINS) || !etheRgbScene_GetValues(commandBuffer->data[0], values))
+	{
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	uint8_t data[ETHERGB_MAX_DATA_LENGTH];
+	uint8_t length = 2;
+	data[0] = commandBuffer->data[0];
+	data[1] = first;
+	for (uint8_t i = first; (i < ETHERGB_MAX_OUTPUT_PINS) && (length < ETHERGB_MAX_DATA_LENGTH); ++i)
+	{
+		data[length++] = values[i];
+	}
+	etheRgbCommand_SetDataResponse(responseBuffer, data, length);
+	return true;
+}
+
+/*!	@brief Store a cue
+ *
+ *	Data: cue, scene (0xFF=none), fade time in ms, hold time in 1/10s
+ *	(0xFFFF=until Go), next cue (0xFF=stop) - times 2 bytes each, MSB
+ *	first
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_SetCue(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbCue_t cue = {
+		.scene = commandBuffer->data[1],
+		.fade = ((uint16_t)commandBuffer->data[2] << 8) | commandBuffer->data[3],
+		.hold = ((uint16_t)commandBuffer->data[4] << 8) | commandBuffer->data[5],
+		.next = commandBuffer->data[6]
+	};
+
+	etheRgbCommand_SetStatusResponse(responseBuffer,
+		etheRgbCue_Set(commandBuffer->data[0], &cue) ? STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Read a cue
+ *
+ *	Response data: as for SetCue
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_GetCue(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbCue_t cue;
+
+	if (!etheRgbCue_Get(commandBuffer->data[0], &cue))
+	{
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	uint8_t data[7] = {
+		commandBuffer->data[0],
+		cue.scene,
+		cue.fade >> 8,
+		cue.fade,
+		cue.hold >> 8,
+		cue.hold,
+		cue.next
+	};
+	etheRgbCommand_SetDataResponse(responseBuffer, data, sizeof(data));
+	return true;
+}
+
+/*!	@brief Start the cue list, or jump to a cue
+ *
+ *	Data: cue
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_StartCues(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbCommand_SetStatusResponse(responseBuffer,
+		etheRgbCue_Start(commandBuffer->data[0]) ? STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Stop the cue list
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_StopCues(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbCue_Stop();
+	etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_OK);
+	return true;
+}
+
+/*!	@brief Continue with the next cue, skipping the rest of the hold
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_GoCue(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbCommand_SetStatusResponse(responseBuffer,
+		etheRgbCue_Go() ? STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Read the running cue
+ *
+ *	Response data: cue (0xFF=stopped)
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_GetCueState(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	uint8_t cue = etheRgbCue_GetCurrent();
+	etheRgbCommand_SetDataResponse(responseBuffer, &cue, 1);
+	return true;
+}
+
+/*!	@brief Write a part of the effect program
+ *
+ *	Stops a running program. Unused data bytes are ignored.
+ *
+ *	Data: offset, length, program bytes
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_WriteVmProgram(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	bool ok = (commandBuffer->data[1] <= ETHERGB_VM_DATA_LENGTH) &&
+		etheRgbVm_WriteProgram(commandBuffer->data[0], &commandBuffer->data[2], commandBuffer->data[1]);
+	etheRgbCommand_SetStatusResponse(responseBuffer, ok ? STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Start the effect program from its beginning
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_StartVm(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbVm_Start();
+	etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_OK);
+	return true;
+}
+
+/*!	@brief Stop the effect program
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_StopVm(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbVm_Stop();
+	etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_OK);
+	return true;
+}
+
+/*!	@brief Read the effect program state
+ *
+ *	Response data: state, program counter, fault
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_GetVmState(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	uint8_t data[3];
+	data[0] = etheRgbVm_GetState(&data[1], &data[2]);
+	etheRgbCommand_SetDataResponse(responseBuffer, data, sizeof(data));
+	return true;
+}
+
+/*!	@brief Set an effect program register, e.g. a parameter
+ *
+ *	Data: register, value MSB, value LSB (Q8.8)
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_SetVmRegister(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	int16_t value = (int16_t)((commandBuffer->data[1] << 8) | commandBuffer->data[2]);
+	etheRgbCommand_SetStatusResponse(responseBuffer,
+		etheRgbVm_SetRegister(commandBuffer->data[0], value) ? STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Schedule a command on the show clock
+ *
+ *	Data: time (4 bytes, MSB first, in ms), command, data length,
+ *	ETHERGB_SCHEDULE_DATA_LENGTH data bytes
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_ScheduleCommand(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	uint32_t time = ((uint32_t)commandBuffer->data[0] << 24) | ((uint32_t)commandBuffer->data[1] << 16) |
+		((uint16_t)commandBuffer->data[2] << 8) | commandBuffer->data[3];
+
+	if (commandBuffer->dataLength < 6 + commandBuffer->data[5])
+	{
+		etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_ERROR);
+		return true;
+	}
+
+	etheRgbCommand_SetStatusResponse(responseBuffer,
+		etheRgbSchedule_Add(time, commandBuffer->data[4], &commandBuffer->data[6], commandBuffer->data[5]) ?
+			STATUS_OK : STATUS_ERROR);
+	return true;
+}
+
+/*!	@brief Read the show clock
+ *
+ *	Response data: time (4 bytes, MSB first, in ms), number of
+ *	scheduled commands
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_GetClock(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	uint32_t time = etheRgbSchedule_GetClock();
+	uint8_t data[5] = {
+		time >> 24, time >> 16, time >> 8, time,
+		etheRgbSchedule_GetCount()
+	};
+	etheRgbCommand_SetDataResponse(responseBuffer, data, sizeof(data));
+	return true;
+}
+
+/*!	@brief Set the show clock
+ *
+ *	Data: time (4 bytes, MSB first, in ms)
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_SetClock(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	uint32_t time = ((uint32_t)commandBuffer->data[0] << 24) | ((uint32_t)commandBuffer->data[1] << 16) |
+		((uint16_t)commandBuffer->data[2] << 8) | commandBuffer->data[3];
+
+	etheRgbSchedule_SetClock(time);
+	etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_OK);
+	return true;
+}
+
+/*!	@brief Drop all scheduled commands
+ *
+ *	@return bool			true
+ *	@date 19.10.26			First implementation					*/
+bool Command_ClearSchedule(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer)
+{
+	etheRgbSchedule_Clear();
+	etheRgbCommand_SetStatusResponse(responseBuffer, STATUS_OK);
+	return true;
+}
+
 /*!	@brief Reboot the device
  *
  *	Hold until watchdog timeout.
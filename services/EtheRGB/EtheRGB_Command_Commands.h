@@ -4,7 +4,12 @@
  *	@author	inselc
  *	@date 13.07.17			Moved from EtheRGB_Command
  *	@date 18.07.17			Added GroupColor commands
- *	@date 23.07.17			Added SetIP and Reboot					*/
+ *	@date 23.07.17			Added SetIP and Reboot
+ *	@date 19.10.26			Added IO mapping commands
+ *	@date 19.10.26			Added pixel commands
+ *	@date 19.10.26			Added scene commands
+ *	@date 19.10.26			Added cue list commands
+ *	@date 19.10.26			Added schedule commands					*/
 
 #ifndef ETHERGB_COMMAND_COMMANDS_H_
 #define ETHERGB_COMMAND_COMMANDS_H_
@@ -16,7 +21,52 @@ bool Command_Test(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuf
 bool Command_SetChannelValue(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
 bool Command_FadeChannelValue(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
 bool Command_SetGroupColor(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SetPixels(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_FillPixels(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_GetPixel(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SetGroupHsv(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SetGroupCct(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_FadeGroupHsv(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SetGroupChannels(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_GetGroupChannels(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SetGroup(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_FadeGroup(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SetGroupLevel(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SetMaster(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
 bool Command_SetIpAddress(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SetIoPin(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SetIoCommand(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SetIoRamp(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_GetIoPin(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_GetIoCommand(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SetIoEncoder(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_GetIoEncoder(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SetIoAnalog(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_GetIoAnalog(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SetIrKey(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_GetIrKey(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_GetIrCode(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SetOutputPin(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_GetOutputPin(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SaveIoConfig(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_StoreScene(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_RecallScene(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_GetScene(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SetCue(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_GetCue(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_StartCues(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_StopCues(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_GoCue(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_GetCueState(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_WriteVmProgram(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_StartVm(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_StopVm(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_GetVmState(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SetVmRegister(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_ScheduleCommand(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_GetClock(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_SetClock(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
+bool Command_ClearSchedule(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
 bool Command_Reboot(etheRgbCommand_t* commandBuffer, etheRgbCommand_t* responseBuffer);
 
 #endif /* ETHERGB_COMMAND_COMMANDS_H_ */
\ No newline at end of file
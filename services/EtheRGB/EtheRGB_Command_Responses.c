@@ -1,7 +1,8 @@
 /*!	@brief EtheRGB Command module response packet builders
  *
  *	@author	inselc
- *	@date 13.07.17			First implementation					*/
+ *	@date 13.07.17			First implementation
+ *	@date 19.10.26			Added data response						*/
 
 #include <stdio.h>
 #include <stdint.h>
@@ -28,4 +29,30 @@ void etheRgbCommand_SetStatusResponse(etheRgbCommand_t* responseBuffer, uint16_t
 	responseBuffer->data[0] = (status >> 8) & 0xFF;
 	responseBuffer->data[1] = status & 0xFF;
 	responseBuffer->data[2] = etheRgbCommand_CalculateChecksum(responseBuffer);
+}
+
+/*!	@brief Populate buffer with a data response
+ *
+ *	@param[out] *responseBuffer	Target buffer
+ *	@param[in] *data		Response data
+ *	@param[in] length		Response data length (truncated to
+ *							ETHERGB_MAX_DATA_LENGTH)
+ *	@date 19.10.26			First implementation					*/
+void etheRgbCommand_SetDataResponse(etheRgbCommand_t* responseBuffer, const uint8_t* data, uint8_t length)
+{
+	if (responseBuffer == NULL || data == NULL)
+	{	
+		LOG_ERROR(SRC_ETHERGB, "Response buffer is NULL");
+		return;
+	}
+
+	if (length > ETHERGB_MAX_DATA_LENGTH)
+		length = ETHERGB_MAX_DATA_LENGTH;
+
+	responseBuffer->commandType = 0x02;
+	responseBuffer->dataLength = length;
+	for (uint8_t i = 0; i < length; ++i)
+	{
+		responseBuffer->data[i] = data[i];
+	}
 }
\ No newline at end of file
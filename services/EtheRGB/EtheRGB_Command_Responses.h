@@ -1,7 +1,8 @@
 /*!	@brief EtheRGB Command module response packet builders
  *
  *	@author	inselc
- *	@date 13.07.17			First implementation					*/
+ *	@date 13.07.17			First implementation
+ *	@date 19.10.26			Added data response						*/
 
 #ifndef ETHERGB_COMMAND_RESPONSES_H_
 #define ETHERGB_COMMAND_RESPONSES_H_
@@ -14,5 +15,6 @@ typedef enum {
 	STATUS_ERROR = 0x0001
 } etheRgbStatusCode_t;
 void etheRgbCommand_SetStatusResponse(etheRgbCommand_t* responseBuffer, uint16_t status);
+void etheRgbCommand_SetDataResponse(etheRgbCommand_t* responseBuffer, const uint8_t* data, uint8_t length);
 
 #endif /* ETHERGB_COMMAND_RESPONSES_H_ */
\ No newline at end of file
@@ -5,6 +5,46 @@
  *  Author: inselc
  */ 
 
+#include "../../core/Input/Input.h"
 #include "EtheRGB_Config.h"
 
-uint8_t EtheRgbServerIpAddress[4] EEMEM = {192, 168, 178, 42};
\ No newline at end of file
+uint8_t EtheRgbServerIpAddress[4] EEMEM = {192, 168, 178, 42};
+
+// Channel pins, R/G/B on PD6/PD5/PD3 by default
+etheRgbDimmerPin_t EtheRgbOutputPins[ETHERGB_MAX_OUTPUT_PINS] EEMEM = {
+	{ INPUT_PORT_D, 6 },
+	{ INPUT_PORT_D, 5 },
+	{ INPUT_PORT_D, 3 },
+	[3 ... ETHERGB_MAX_OUTPUT_PINS - 1] = { .port = INPUT_PORT_NONE }
+};
+
+// IO mappings, all unused by default
+etheRgbIoConfig_t EtheRgbIoConfig[ETHERGB_MAX_COMMAND_PINS] EEMEM = {
+	[0 ... ETHERGB_MAX_COMMAND_PINS - 1] = { .port = INPUT_PORT_NONE }
+};
+etheRgbIoEncoderConfig_t EtheRgbIoEncoderConfig[ETHERGB_MAX_ENCODERS] EEMEM = {
+	[0 ... ETHERGB_MAX_ENCODERS - 1] = { .port = INPUT_PORT_NONE }
+};
+etheRgbIoAnalogConfig_t EtheRgbIoAnalogConfig[ETHERGB_MAX_ANALOG_INPUTS] EEMEM = {
+	[0 ... ETHERGB_MAX_ANALOG_INPUTS - 1] = { .input = ETHERGB_IO_ANALOG_NONE }
+};
+etheRgbIoIrKey_t EtheRgbIoIrKeys[ETHERGB_MAX_IR_KEYS] EEMEM = {
+	[0 ... ETHERGB_MAX_IR_KEYS - 1] = { .protocol = IR_PROTOCOL_NONE }
+};
+
+// Scenes, all channels off by default
+uint8_t EtheRgbScenes[ETHERGB_MAX_SCENES][ETHERGB_MAX_OUTPUT_PINS] EEMEM = {{ 0 }};
+
+// Cue list, empty by default
+etheRgbCue_t EtheRgbCues[ETHERGB_MAX_CUES] EEMEM = {
+	[0 ... ETHERGB_MAX_CUES - 1] = { .scene = ETHERGB_SCENE_NONE, .hold = ETHERGB_CUE_HOLD_WAIT, .next = ETHERGB_CUE_NONE }
+};
+
+// Effect program, halting right away by default
+uint8_t EtheRgbVmProgram[ETHERGB_VM_PROGRAM_SIZE] EEMEM = { VM_OP_HALT };
+
+// Groups, the default R/G/B channels in the first one
+etheRgbGroupChannels_t EtheRgbGroups[ETHERGB_MAX_GROUPS] EEMEM = {
+	{ { 0, 1, 2, ETHERGB_GROUP_CHANNEL_NONE, ETHERGB_GROUP_CHANNEL_NONE } },
+	[1 ... ETHERGB_MAX_GROUPS - 1] = { { [0 ... GROUP_ROLE_COUNT - 1] = ETHERGB_GROUP_CHANNEL_NONE } }
+};
\ No newline at end of file
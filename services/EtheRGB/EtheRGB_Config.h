@@ -9,8 +9,26 @@
 #ifndef ETHERGB_CONFIG_H_
 #define ETHERGB_CONFIG_H_
 
+#include <stdint.h>
+#include <stdbool.h>
 #include <avr/eeprom.h>
+#include "EtheRGB_Command.h"
+#include "EtheRGB_IO.h"
+#include "EtheRGB_Dimmer.h"
+#include "EtheRGB_Scene.h"
+#include "EtheRGB_Cue.h"
+#include "EtheRGB_Vm.h"
+#include "EtheRGB_Group.h"
 
 extern uint8_t EtheRgbServerIpAddress[4] EEMEM;
+extern etheRgbDimmerPin_t EtheRgbOutputPins[ETHERGB_MAX_OUTPUT_PINS] EEMEM;
+extern etheRgbIoConfig_t EtheRgbIoConfig[ETHERGB_MAX_COMMAND_PINS] EEMEM;
+extern etheRgbIoEncoderConfig_t EtheRgbIoEncoderConfig[ETHERGB_MAX_ENCODERS] EEMEM;
+extern etheRgbIoAnalogConfig_t EtheRgbIoAnalogConfig[ETHERGB_MAX_ANALOG_INPUTS] EEMEM;
+extern etheRgbIoIrKey_t EtheRgbIoIrKeys[ETHERGB_MAX_IR_KEYS] EEMEM;
+extern uint8_t EtheRgbScenes[ETHERGB_MAX_SCENES][ETHERGB_MAX_OUTPUT_PINS] EEMEM;
+extern etheRgbCue_t EtheRgbCues[ETHERGB_MAX_CUES] EEMEM;
+extern uint8_t EtheRgbVmProgram[ETHERGB_VM_PROGRAM_SIZE] EEMEM;
+extern etheRgbGroupChannels_t EtheRgbGroups[ETHERGB_MAX_GROUPS] EEMEM;
 
 #endif /* ETHERGB_CONFIG_H_ */
\ No newline at end of file
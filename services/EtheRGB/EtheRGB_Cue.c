@@ -0,0 +1,153 @@
+/*!	@brief EtheRGB Cue list module
+ *
+ *	The cue list is held in EEPROM; only the running cue is read into
+ *	RAM. Cue times are kept on the millisecond clock, relative to the
+ *	start of the first cue, so the sequence neither drifts with the
+ *	polling rate nor depends on the network once started. The fades
+ *	are run by the dimmer's crossfade.
+ *
+ *	@author	inselc
+ *	@date 19.10.26			First implementation					*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <avr/eeprom.h>
+#include "../../core/Clock/Clock.h"
+#include "../../core/Log/Log.h"
+#include "EtheRGB_Command.h"
+#include "EtheRGB_Dimmer.h"
+#include "EtheRGB_Scene.h"
+#include "EtheRGB_Cue.h"
+#include "EtheRGB_Config.h"
+
+static uint8_t CueIndex = ETHERGB_CUE_NONE;		//!< Running cue, or ETHERGB_CUE_NONE
+static etheRgbCue_t CueCurrent;					//!< Copy of the running cue
+static uint32_t CueStartTime = 0;				//!< Start of the running cue, in ms
+
+/*!	@brief Enter a cue
+ *
+ *	@param[in] index		Cue number, or ETHERGB_CUE_NONE to stop
+ *	@param[in] time			Start time of the cue, in ms
+ *	@date 19.10.26			First implementation					*/
+static void etheRgbCue_Enter(uint8_t index, uint32_t time)
+{
+	if (index >= ETHERGB_MAX_CUES)
+	{
+		CueIndex = ETHERGB_CUE_NONE;
+		return;
+	}
+
+	eeprom_read_block(&CueCurrent, &EtheRgbCues[index], sizeof(CueCurrent));
+	CueIndex = index;
+	CueStartTime = time;
+
+	if (CueCurrent.scene != ETHERGB_SCENE_NONE)
+	{
+		etheRgbScene_Recall(CueCurrent.scene, CueCurrent.fade);
+	}
+}
+
+/*!	@brief Initialize the cue list module
+ *
+ *	@date 19.10.26			First implementation					*/
+void etheRgbCue_Init(void)
+{
+	CueIndex = ETHERGB_CUE_NONE;
+}
+
+/*!	@brief Cue list polling routine
+ *
+ *	Continues with the next cue once the running one has held for
+ *	its hold time.
+ *
+ *	@date 19.10.26			First implementation					*/
+void etheRgbCue_Poll(void)
+{
+	if ((CueIndex == ETHERGB_CUE_NONE) || (CueCurrent.hold == ETHERGB_CUE_HOLD_WAIT))
+		return;
+
+	uint32_t duration = CueCurrent.fade + (uint32_t)CueCurrent.hold * 100;
+	if (clockMillis() - CueStartTime < duration)
+		return;
+
+	// Next cue starts when this one ended, not when polled
+	etheRgbCue_Enter(CueCurrent.next, CueStartTime + duration);
+}
+
+/*!	@brief Read a cue
+ *
+ *	@param[in] index		Cue number
+ *	@param[out] *cue		Cue
+ *	@return bool			false, if the cue number is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbCue_Get(uint8_t index, etheRgbCue_t* cue)
+{
+	if (index >= ETHERGB_MAX_CUES || cue == NULL)
+		return false;
+
+	eeprom_read_block(cue, &EtheRgbCues[index], sizeof(*cue));
+	return true;
+}
+
+/*!	@brief Store a cue
+ *
+ *	A running cue keeps its old settings until it is entered again.
+ *
+ *	@param[in] index		Cue number
+ *	@param[in] *cue			Cue
+ *	@return bool			false, if the cue number is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbCue_Set(uint8_t index, const etheRgbCue_t* cue)
+{
+	if (index >= ETHERGB_MAX_CUES || cue == NULL)
+		return false;
+
+	eeprom_update_block(cue, &EtheRgbCues[index], sizeof(*cue));
+	return true;
+}
+
+/*!	@brief Start the cue list at a cue
+ *
+ *	@param[in] index		Cue number
+ *	@return bool			false, if the cue number is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbCue_Start(uint8_t index)
+{
+	if (index >= ETHERGB_MAX_CUES)
+		return false;
+
+	etheRgbCue_Enter(index, clockMillis());
+	return true;
+}
+
+/*!	@brief Stop the cue list
+ *
+ *	The channels keep their values; a running crossfade completes.
+ *
+ *	@date 19.10.26			First implementation					*/
+void etheRgbCue_Stop(void)
+{
+	CueIndex = ETHERGB_CUE_NONE;
+}
+
+/*!	@brief Continue with the next cue right away
+ *
+ *	@return bool			false, if no cue is running
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbCue_Go(void)
+{
+	if (CueIndex == ETHERGB_CUE_NONE)
+		return false;
+
+	etheRgbCue_Enter(CueCurrent.next, clockMillis());
+	return true;
+}
+
+/*!	@brief Get the running cue
+ *
+ *	@return uint8_t			Cue number, or ETHERGB_CUE_NONE
+ *	@date 19.10.26			First implementation					*/
+uint8_t etheRgbCue_GetCurrent(void)
+{
+	return CueIndex;
+}
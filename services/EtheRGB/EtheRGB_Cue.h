@@ -0,0 +1,44 @@
+/*!	@brief EtheRGB Cue list module
+ *
+ *	Plays a list of cues stored on the device: each cue crossfades to
+ *	a scene, holds it, and continues with its next cue.
+ *
+ *	@author	inselc
+ *	@date 19.10.26			First implementation					*/
+
+#ifndef ETHERGB_CUE_H_
+#define ETHERGB_CUE_H_
+
+/*!	@file */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ETHERGB_MAX_CUES			24
+#define ETHERGB_CUE_NONE			0xFF	/* etheRgbCue_t::next: stop after the hold */
+#define ETHERGB_CUE_HOLD_WAIT		0xFFFF	/* etheRgbCue_t::hold: hold until etheRgbCue_Go */
+
+/*!	@struct etheRgbCue_t
+ *	@brief Cue list entry
+ *
+ *	A scene of ETHERGB_SCENE_NONE (or erased EEPROM) leaves the
+ *	channels unchanged, for a pure wait.
+ *
+ *	@date 19.10.26			First implementation					*/
+typedef struct __attribute__((packed)) {
+	uint8_t scene;				//!< Scene to crossfade to
+	uint16_t fade;				//!< Crossfade duration, in ms
+	uint16_t hold;				//!< Hold time after the crossfade, in 1/10s
+	uint8_t next;				//!< Cue to continue with, or ETHERGB_CUE_NONE
+} etheRgbCue_t;
+
+void etheRgbCue_Init(void);
+void etheRgbCue_Poll(void);
+bool etheRgbCue_Get(uint8_t index, etheRgbCue_t* cue);
+bool etheRgbCue_Set(uint8_t index, const etheRgbCue_t* cue);
+bool etheRgbCue_Start(uint8_t index);
+void etheRgbCue_Stop(void);
+bool etheRgbCue_Go(void);
+uint8_t etheRgbCue_GetCurrent(void);
+
+#endif /* ETHERGB_CUE_H_ */
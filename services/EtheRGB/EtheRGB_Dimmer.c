@@ -1,92 +1,428 @@
 /*!	@brief EtheRGB Dimmer Controller module
+ *
+ *	Every channel can be assigned to any free pin of PORTB, PORTC or
+ *	PORTD. With the 74HC595 or PCA9685 backend, the channels are wired
+ *	to the external outputs instead and cannot be assigned. Value
+ *	changes are handed to the dimmer once per polling cycle.
+ *
+ *	Besides the per-channel fades, all channels can crossfade to new
+ *	values over a duration. All channels of a crossfade are
+ *	interpolated from the same elapsed time on the millisecond clock,
+ *	so they arrive together, whatever the distances. Setting or fading
+ *	a channel takes it out of a running crossfade.
+ *
+ *	Every channel has an output scale (a group submaster), and all
+ *	channels are scaled by the master level, on the way to the dimmer
+ *	only; values read back and stored in scenes are unscaled. Scaled
+ *	values are recomputed for changed channels only, tracked in a bit
+ *	mask. A master change rescales all channels, which costs a pass
+ *	over the channels like the dimmer update that follows it; a master
+ *	fade does so only when the 8 bit level steps, so at most 255 times
+ *	for a full fade, and at most once per millisecond. Applying the
+ *	master further downstream would not save the pass, since the bit
+ *	planes are rebuilt for any master change anyway.
+ *
+ *	Crossfades and scaling keep 8 fraction bits below the value step.
+ *	With a dithering dimmer (DIMMER_DITHER), the fractions of the
+ *	scaled values are handed on, so long fades and low master levels
+ *	dim smoothly instead of in visible steps. Fractions alone change
+ *	no bit planes, so they need no dimmer update.
  *
  *	@author	inselc
- *	@date 11.07.17			First implementation					*/
+ *	@date 11.07.17			First implementation
+ *	@date 19.10.26			Configurable channel pins
+ *	@date 19.10.26			74HC595 backend
+ *	@date 19.10.26			PCA9685 backend
+ *	@date 19.10.26			Timed crossfades
+ *	@date 19.10.26			Output scaling
+ *	@date 19.10.26			Master level, incremental scaling
+ *	@date 19.10.26			Fractions for temporal dithering
+ *	@date 19.10.26			Cost of master changes					*/
 
 #include <stdio.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <avr/interrupt.h>
+#include <avr/eeprom.h>
 #include "../../modules/io/io.h"
 #include "../../core/Serial/Serial.h"
 #include "../../core/Log/Log.h"
+#include "../../core/Clock/Clock.h"
 #include "../../core/Dimmer/Dimmer.h"
+#include "../../core/Input/Input.h"
+#include "EtheRGB_Command.h"
 #include "EtheRGB_Dimmer.h"
+#include "EtheRGB_IO.h"
+#include "EtheRGB_Config.h"
 
-static pin_t dimPinB = { // R
-	.DDR = &DDRD,
-	.Direction = OUTPUT,
-	.Number = 3,
-	.PINR = &PIND,
-	.Port = &PORTD,
-	.PullUp = false
-};
-static pin_t dimPinG = { // G
-	.DDR = &DDRD,
-	.Direction = OUTPUT,
-	.Number = 5,
-	.PINR = &PIND,
-	.Port = &PORTD,
-	.PullUp = false
-};
-static pin_t dimPinR = { // B
-	.DDR = &DDRD,
-	.Direction = OUTPUT,
-	.Number = 6,
-	.PINR = &PIND,
-	.Port = &PORTD,
-	.PullUp = false
+static pin_t OutputPinStorage[ETHERGB_MAX_OUTPUT_PINS];		//!< Pin descriptions of assigned channels
+static etheRgbDimmerPin_t OutputPinMap[ETHERGB_MAX_OUTPUT_PINS];	//!< Channel to pin assignment
+static bool OutputValuesChanged = false;		//!< Values or scales changed since the last scaling
+static bool OutputLevelsChanged = false;		//!< Scaled values differ from the dimmer's bit planes
+static uint8_t OutputCurrentFractions[ETHERGB_MAX_OUTPUT_PINS];	//!< Fractions of the values, in 1/256
+static bool OutputCrossfading[ETHERGB_MAX_OUTPUT_PINS];		//!< Channel is part of the crossfade
+static uint8_t CrossfadeStartValues[ETHERGB_MAX_OUTPUT_PINS];	//!< Values at the start of the crossfade
+static uint32_t CrossfadeStartTime = 0;			//!< Start of the crossfade, in ms
+static uint16_t CrossfadeDuration = 0;			//!< Duration of the crossfade, in ms
+static bool CrossfadeActive = false;			//!< A crossfade is running
+static uint8_t OutputScales[ETHERGB_MAX_OUTPUT_PINS] = {	//!< Output scales, 0xFF = full
+	[0 ... ETHERGB_MAX_OUTPUT_PINS - 1] = 0xFF
 };
+static uint8_t OutputLevels[ETHERGB_MAX_OUTPUT_PINS];		//!< Scaled values, read by the dimmer
+static uint8_t OutputFractions[ETHERGB_MAX_OUTPUT_PINS];	//!< Fractions of the scaled values, for dithering
+static uint8_t OutputDirty[(ETHERGB_MAX_OUTPUT_PINS + 7) / 8];	//!< Channels to rescale, bit mask
+static bool OutputRescaleAll = true;			//!< Rescale all channels
+static uint8_t MasterLevel = 0xFF;				//!< Master level, 0xFF = full
+static uint8_t MasterStartLevel = 0xFF;			//!< Master level at the start of the fade
+static uint8_t MasterTargetLevel = 0xFF;		//!< Master level at the end of the fade
+static uint32_t MasterStartTime = 0;			//!< Start of the master fade, in ms
+static uint16_t MasterDuration = 0;				//!< Duration of the master fade, in ms
+static uint32_t MasterLastPoll = 0;				//!< Time of the last master fade step, in ms
+static bool MasterFading = false;				//!< A master fade is running
 
-pin_t* OutputPins[ETHERGB_MAX_OUTPUT_PINS] = { &dimPinR, &dimPinG, &dimPinB };
+pin_t* OutputPins[ETHERGB_MAX_OUTPUT_PINS] = { NULL };
 uint8_t OutputCurrentValues[ETHERGB_MAX_OUTPUT_PINS] = {0x00};
 uint8_t OutputFadingCounters[ETHERGB_MAX_OUTPUT_PINS] = {0x00};
 uint8_t OutputFadingSpeeds[ETHERGB_MAX_OUTPUT_PINS] = {0x00};
 uint8_t OutputTargetValues[ETHERGB_MAX_OUTPUT_PINS] = {0x00};
 
+/*!	@brief Check a channel to pin assignment
+ *
+ *	@param[in] channel		Channel number
+ *	@param[in] *pin			Pin assignment
+ *	@return bool			true, if the pin is free to use
+ *	@date 19.10.26			First implementation					*/
+static bool etheRgbDimmer_IsPinValid(uint8_t channel, const etheRgbDimmerPin_t* pin)
+{
+	if (pin->port == INPUT_PORT_NONE)
+		return true;
+	if ((pin->port >= INPUT_PORT_COUNT) || (pin->number > 7))
+		return false;
+
+	for (uint8_t i = 0; i < ETHERGB_MAX_OUTPUT_PINS; ++i)
+	{
+		if ((i != channel) && (OutputPinMap[i].port == pin->port) && (OutputPinMap[i].number == pin->number))
+			return false;
+	}
+	return etheRgbIO_IsPinFree(pin->port, pin->number);
+}
+
+/*!	@brief Assign a pin to a channel, without restarting the dimmer
+ *
+ *	@param[in] channel		Channel number
+ *	@param[in] *pin			Pin assignment
+ *	@date 19.10.26			First implementation					*/
+static void etheRgbDimmer_ApplyOutputPin(uint8_t channel, const etheRgbDimmerPin_t* pin)
+{
+	// Release the previous pin
+	if (OutputPins[channel] != NULL)
+	{
+		ioSetPinDirection(OutputPins[channel], INPUT);
+		OutputPins[channel] = NULL;
+	}
+
+	OutputPinMap[channel] = *pin;
+	if (pin->port == INPUT_PORT_NONE)
+		return;
+
+	inputMakePin(&OutputPinStorage[channel], pin->port, pin->number, false);
+	OutputPinStorage[channel].Direction = OUTPUT;
+	ioInitPin(&OutputPinStorage[channel]);
+	OutputPins[channel] = &OutputPinStorage[channel];
+}
+
+/*!	@brief Mark a channel's value or scale changed
+ *
+ *	@param[in] channel		Channel number
+ *	@date 19.10.26			First implementation					*/
+static inline void etheRgbDimmer_MarkChanged(uint8_t channel)
+{
+	OutputDirty[channel >> 3] |= 1 << (channel & 0x07);
+	OutputValuesChanged = true;
+}
+
+/*!	@brief Scale a channel's value for the dimmer
+ *
+ *	@param[in] channel		Channel number
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Keep the fraction						*/
+static inline void etheRgbDimmer_ApplyScale(uint8_t channel)
+{
+	// Value with fraction, 8.8 fixed point
+	uint32_t level = ((uint16_t)OutputCurrentValues[channel] << 8) | OutputCurrentFractions[channel];
+	level = (level * (OutputScales[channel] + 1)) >> 8;
+	level = (level * (MasterLevel + 1)) >> 8;
+
+	if ((uint8_t)(level >> 8) != OutputLevels[channel])
+	{
+		OutputLevels[channel] = level >> 8;
+		OutputLevelsChanged = true;
+	}
+	OutputFractions[channel] = (uint8_t)level;
+}
+
+/*!	@brief Scale the changed channel values for the dimmer
+ *
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Changed channels only, master level		*/
+static void etheRgbDimmer_ApplyScales(void)
+{
+	if (OutputRescaleAll)
+	{
+		for (uint8_t i = 0; i < ETHERGB_MAX_OUTPUT_PINS; ++i)
+		{
+			etheRgbDimmer_ApplyScale(i);
+		}
+		for (uint8_t i = 0; i < sizeof(OutputDirty); ++i)
+		{
+			OutputDirty[i] = 0;
+		}
+		OutputRescaleAll = false;
+		return;
+	}
+
+	for (uint8_t i = 0; i < sizeof(OutputDirty); ++i)
+	{
+		uint8_t dirty = OutputDirty[i];
+		if (dirty == 0)
+			continue;
+
+		OutputDirty[i] = 0;
+		for (uint8_t bit = 0; dirty != 0; ++bit, dirty >>= 1)
+		{
+			if (dirty & 0x01)
+				etheRgbDimmer_ApplyScale((i << 3) + bit);
+		}
+	}
+}
+
+/*!	@brief Master fade polling routine
+ *
+ *	Steps the fade at most once per millisecond.
+ *
+ *	@date 19.10.26			First implementation					*/
+static void etheRgbDimmer_PollMaster(void)
+{
+	uint32_t now = clockMillis();
+	if (now == MasterLastPoll)
+		return;
+	MasterLastPoll = now;
+
+	uint32_t elapsed = now - MasterStartTime;
+	bool done = (elapsed >= MasterDuration);
+	uint16_t progress = done ? 0x100 : (uint16_t)((elapsed << 8) / MasterDuration);
+
+	uint8_t level = (MasterTargetLevel >= MasterStartLevel) ?
+		MasterStartLevel + (uint8_t)(((uint16_t)(MasterTargetLevel - MasterStartLevel) * progress) >> 8) :
+		MasterStartLevel - (uint8_t)(((uint16_t)(MasterStartLevel - MasterTargetLevel) * progress) >> 8);
+
+	if (level != MasterLevel)
+	{
+		MasterLevel = level;
+		OutputRescaleAll = true;
+		OutputValuesChanged = true;
+	}
+	if (done)
+		MasterFading = false;
+}
+
 /*!	@brief Initialize the dimmer module
  *
- *	@todo: Use all 7 output pins
+ *	Loads the channel to pin assignment from EEPROM, unless the
+ *	dimmer backend has fixed outputs.
  *
  *	@date 11.07.17			First implementation 
- *	@date 14.07.17			Rework									*/
+ *	@date 14.07.17			Rework
+ *	@date 19.10.26			Configurable pins for all channels
+ *	@date 19.10.26			74HC595 backend
+ *	@date 19.10.26			PCA9685 backend
+ *	@date 19.10.26			Output scaling
+ *	@date 19.10.26			Temporal dithering
+ *	@date 19.10.26			All channels start dark					*/
 void etheRgbDimmer_Init(void)
 {
-	ioInitPin(&dimPinR);
-	ioInitPin(&dimPinG);
-	ioInitPin(&dimPinB);
+	for (uint8_t i = 0; i < ETHERGB_MAX_OUTPUT_PINS; ++i)
+	{
+		OutputPinMap[i].port = INPUT_PORT_NONE;
+	}
+#if !defined(DIMMER_FIXED_OUTPUTS)
+	etheRgbDimmerPin_t pin;
+	for (uint8_t i = 0; i < ETHERGB_MAX_OUTPUT_PINS; ++i)
+	{
+		eeprom_read_block(&pin, &EtheRgbOutputPins[i], sizeof(pin));
+		if (!etheRgbDimmer_IsPinValid(i, &pin))
+			pin.port = INPUT_PORT_NONE;
+		etheRgbDimmer_ApplyOutputPin(i, &pin);
+	}
+#endif
+
+	etheRgbDimmer_ApplyScales();
+#if defined(DIMMER_DITHER)
+	dimmerSetFractions(OutputFractions);
+#endif
+
+	dimmerInit(OutputPins, OutputLevels, ETHERGB_MAX_OUTPUT_PINS);
+}
+
+/*!	@brief Read a channel's pin assignment
+ *
+ *	@param[in] channel		Channel number
+ *	@param[out] *pin		Pin assignment
+ *	@return bool			false, if the channel is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbDimmer_GetOutputPin(uint8_t channel, etheRgbDimmerPin_t* pin)
+{
+	if (channel >= ETHERGB_MAX_OUTPUT_PINS || pin == NULL)
+		return false;
+
+	*pin = OutputPinMap[channel];
+	return true;
+}
+
+/*!	@brief Assign a pin to a channel
+ *
+ *	Takes effect immediately, and is written to EEPROM.
+ *
+ *	@param[in] channel		Channel number
+ *	@param[in] *pin			Pin assignment, port INPUT_PORT_NONE for none
+ *	@return bool			false, if the pin is invalid or in use,
+ *							always false with fixed outputs
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			PCA9685 backend
+ *	@date 19.10.26			Output scaling
+ *	@date 19.10.26			Released pins left without pull-up		*/
+bool etheRgbDimmer_SetOutputPin(uint8_t channel, const etheRgbDimmerPin_t* pin)
+{
+	if (channel >= ETHERGB_MAX_OUTPUT_PINS || pin == NULL)
+		return false;
+#if defined(DIMMER_FIXED_OUTPUTS)
+	// Channels are wired to the external outputs
+	return false;
+#else
+	if (!etheRgbDimmer_IsPinValid(channel, pin))
+		return false;
 
-	OutputPins[0] = &dimPinR;
-	OutputPins[1] = &dimPinG;
-	OutputPins[2] = &dimPinB;
+	pin_t previous = OutputPinStorage[channel];
+	bool released = (OutputPins[channel] != NULL);
 
-	OutputCurrentValues[1] = 0x04;
+	etheRgbDimmer_ApplyOutputPin(channel, pin);
+	eeprom_update_block(pin, &EtheRgbOutputPins[channel], sizeof(*pin));
 
-	dimmerInit(OutputPins, OutputCurrentValues, 3);//ETHERGB_MAX_OUTPUT_PINS);
+	// Regroup the outputs by port
+	dimmerInit(OutputPins, OutputLevels, ETHERGB_MAX_OUTPUT_PINS);
+
+	// The dimmer may have driven the released pin high until now,
+	// which would leave its pull-up on
+	if (released && ((previous.Port != OutputPinStorage[channel].Port) || (previous.Number != OutputPinStorage[channel].Number)))
+		ioWritePin(&previous, LOW);
+	return true;
+#endif
+}
+
+/*!	@brief Get the pins of a port used as outputs
+ *
+ *	@param[in] port			Port (inputPort_t)
+ *	@return uint8_t			Pin bit mask
+ *	@date 19.10.26			First implementation					*/
+uint8_t etheRgbDimmer_GetOutputMask(uint8_t port)
+{
+	uint8_t mask = 0;
+	for (uint8_t i = 0; i < ETHERGB_MAX_OUTPUT_PINS; ++i)
+	{
+		if (OutputPinMap[i].port == port)
+			mask |= 1 << OutputPinMap[i].number;
+	}
+	return mask;
 }
 
 /*!	@brief Reset all dimmer values to initial states (off)
  *
- *	@date 14.07.17			First implementation					*/
+ *	@date 14.07.17			First implementation
+ *	@date 19.10.26			Mark values changed
+ *	@date 19.10.26			Cancel the crossfade
+ *	@date 19.10.26			Rescale all channels					*/
 void etheRgbDimmer_Reset(void)
 {
 	for (int i=0; i < ETHERGB_MAX_OUTPUT_PINS; ++i)
 	{	
 		OutputCurrentValues[i] = 0x00;
+		OutputCurrentFractions[i] = 0x00;
 		OutputFadingSpeeds[i] = 0x00;
 		OutputFadingCounters[i] = 0x00;
 		OutputTargetValues[i] = 0x00;
+		OutputCrossfading[i] = false;
+	}
+	CrossfadeActive = false;
+	OutputRescaleAll = true;
+	OutputValuesChanged = true;
+}
+
+/*!	@brief Crossfade polling routine
+ *
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Fractions								*/
+static void etheRgbDimmer_PollCrossfade(void)
+{
+	uint32_t elapsed = clockMillis() - CrossfadeStartTime;
+	bool done = (elapsed >= CrossfadeDuration);
+
+	// Progress in 1/256, the same for all channels
+	uint16_t progress = done ? 0x100 : (uint16_t)((elapsed << 8) / CrossfadeDuration);
+
+	for (uint8_t i = 0; i < ETHERGB_MAX_OUTPUT_PINS; ++i)
+	{
+		if (!OutputCrossfading[i])
+			continue;
+
+		// Value with fraction, 8.8 fixed point
+		uint8_t start = CrossfadeStartValues[i];
+		uint8_t target = OutputTargetValues[i];
+		uint16_t value = (target >= start) ?
+			((uint16_t)start << 8) + (uint16_t)(target - start) * progress :
+			((uint16_t)start << 8) - (uint16_t)(start - target) * progress;
+
+		if ((value >> 8) != OutputCurrentValues[i] || (uint8_t)value != OutputCurrentFractions[i])
+		{
+			cli();
+			OutputCurrentValues[i] = value >> 8;
+			sei();
+			OutputCurrentFractions[i] = (uint8_t)value;
+			etheRgbDimmer_MarkChanged(i);
+		}
+		if (done)
+			OutputCrossfading[i] = false;
 	}
+
+	if (done)
+		CrossfadeActive = false;
 }
 
 /*!	@brief Dimmer module polling routine
  *
- *	Handles channel fading
+ *	Handles channel fading, and passes changed values on to the
+ *	dimmer.
  *
- *	@date 15.07.17			First implementation					*/
+ *	@date 15.07.17			First implementation
+ *	@date 19.10.26			Update the dimmer's bit planes
+ *	@date 19.10.26			Timed crossfades
+ *	@date 19.10.26			Output scaling
+ *	@date 19.10.26			Master fade								*/
 void etheRgbDimmer_Poll(void)
 {
+	if (CrossfadeActive)
+	{
+		etheRgbDimmer_PollCrossfade();
+	}
+	if (MasterFading)
+	{
+		etheRgbDimmer_PollMaster();
+	}
+
 	for (int i=0; i < ETHERGB_MAX_OUTPUT_PINS; ++i)
 	{	
+		if (OutputCrossfading[i])
+			continue;
+
 		if (OutputCurrentValues[i] != OutputTargetValues[i])
 		{	
 			if (OutputFadingCounters[i] < 0xFF - OutputFadingSpeeds[i])
@@ -114,21 +450,37 @@ void etheRgbDimmer_Poll(void)
 				}
 				
 				OutputFadingCounters[i] = 0x00;
+				OutputCurrentFractions[i] = 0x00;
+				etheRgbDimmer_MarkChanged(i);
 			}
 		}
 	}
+
+	if (OutputValuesChanged)
+	{
+		etheRgbDimmer_ApplyScales();
+		OutputValuesChanged = false;
+	}
+
+	// Retried in the next cycle if the previous update is still pending
+	if (OutputLevelsChanged && dimmerUpdate())
+	{
+		OutputLevelsChanged = false;
+	}
 }
 
 /*!	@brief Set single channel value
  *
  *	@param[in] channel		Channel number
  *	@param[in] value		Brightness value						
- *	@date 15.07.17			First implementation					*/
+ *	@date 15.07.17			First implementation
+ *	@date 19.10.26			Mark values changed
+ *	@date 19.10.26			Leave the crossfade						*/
 void etheRgbDimmer_SetChannelValue(uint8_t channel, uint8_t value)
 {
 	if (channel >= ETHERGB_MAX_OUTPUT_PINS)
 	{
-		LOG_ERROR(SRC_ETHERGB, "Index out of bounds.");
+		LOG_EVENT(SRC_ETHERGB, LOG_EVT_DIMMER_INVALID_CHANNEL, channel);
 		return;
 	}
 
@@ -136,7 +488,10 @@ void etheRgbDimmer_SetChannelValue(uint8_t channel, uint8_t value)
 	// Pause interrupts to prevent race conditions
 	OutputCurrentValues[channel] = value;
 	sei();
+	OutputCurrentFractions[channel] = 0x00;
 	OutputTargetValues[channel] = value;
+	OutputCrossfading[channel] = false;
+	etheRgbDimmer_MarkChanged(channel);
 }
 
 /*!	@brief Set a channel's fading speed
@@ -148,7 +503,7 @@ void etheRgbDimmer_SetChannelFadeSpeed(uint8_t channel, uint8_t speed)
 {
 	if (channel >= ETHERGB_MAX_OUTPUT_PINS)
 	{
-		LOG_ERROR(SRC_ETHERGB, "Index out of bounds.");
+		LOG_EVENT(SRC_ETHERGB, LOG_EVT_DIMMER_INVALID_CHANNEL, channel);
 		return;
 	}
 
@@ -159,14 +514,146 @@ void etheRgbDimmer_SetChannelFadeSpeed(uint8_t channel, uint8_t speed)
  *
  *	@param[in] channel		Channel number
  *	@param[in] value		Target brightness value
- *	@date 15.07.17			First implementation					*/
+ *	@date 15.07.17			First implementation
+ *	@date 19.10.26			Leave the crossfade						*/
 void etheRgbDimmer_SetChannelFadeValue(uint8_t channel, uint8_t value)
 {
 	if (channel >= ETHERGB_MAX_OUTPUT_PINS)
 	{
-		LOG_ERROR(SRC_ETHERGB, "Index out of bounds.");
+		LOG_EVENT(SRC_ETHERGB, LOG_EVT_DIMMER_INVALID_CHANNEL, channel);
 		return;
 	}
 
 	OutputTargetValues[channel] = value;
-}
\ No newline at end of file
+	OutputCrossfading[channel] = false;
+}
+
+/*!	@brief Stop a running fade at the current value
+ *
+ *	@param[in] channel		Channel number
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Leave the crossfade						*/
+void etheRgbDimmer_StopChannelFade(uint8_t channel)
+{
+	if (channel >= ETHERGB_MAX_OUTPUT_PINS)
+	{
+		LOG_EVENT(SRC_ETHERGB, LOG_EVT_DIMMER_INVALID_CHANNEL, channel);
+		return;
+	}
+
+	OutputTargetValues[channel] = OutputCurrentValues[channel];
+	OutputFadingCounters[channel] = 0x00;
+	OutputCrossfading[channel] = false;
+}
+
+/*!	@brief Get a channel's current value
+ *
+ *	@param[in] channel		Channel number
+ *	@return uint8_t			Current brightness value
+ *	@date 19.10.26			First implementation					*/
+uint8_t etheRgbDimmer_GetChannelValue(uint8_t channel)
+{
+	if (channel >= ETHERGB_MAX_OUTPUT_PINS)
+	{
+		LOG_EVENT(SRC_ETHERGB, LOG_EVT_DIMMER_INVALID_CHANNEL, channel);
+		return 0;
+	}
+
+	return OutputCurrentValues[channel];
+}
+
+/*!	@brief Check whether a channel is fading
+ *
+ *	@param[in] channel		Channel number
+ *	@return bool			true, while a fade or crossfade moves the channel
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbDimmer_IsChannelFading(uint8_t channel)
+{
+	if (channel >= ETHERGB_MAX_OUTPUT_PINS)
+	{
+		LOG_EVENT(SRC_ETHERGB, LOG_EVT_DIMMER_INVALID_CHANNEL, channel);
+		return false;
+	}
+
+	return OutputCrossfading[channel] || (OutputCurrentValues[channel] != OutputTargetValues[channel]);
+}
+
+/*!	@brief Crossfade all channels to new values
+ *
+ *	Replaces a running crossfade and all per-channel fades. The
+ *	channels take the new values after the duration, all at the same
+ *	time.
+ *
+ *	@param[in] *values		Target values, for all channels
+ *	@param[in] duration		Duration in ms, 0 to set the values at once
+ *	@date 19.10.26			First implementation					*/
+void etheRgbDimmer_Crossfade(const uint8_t* values, uint16_t duration)
+{
+	for (uint8_t i = 0; i < ETHERGB_MAX_OUTPUT_PINS; ++i)
+	{
+		CrossfadeStartValues[i] = OutputCurrentValues[i];
+		OutputTargetValues[i] = values[i];
+		OutputFadingCounters[i] = 0x00;
+		OutputCrossfading[i] = true;
+	}
+
+	CrossfadeStartTime = clockMillis();
+	CrossfadeDuration = duration;
+	CrossfadeActive = true;
+
+	// Zero duration completes right away
+	etheRgbDimmer_PollCrossfade();
+}
+
+/*!	@brief Check for a running crossfade
+ *
+ *	@return bool			true, until the crossfade has completed
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbDimmer_IsCrossfading(void)
+{
+	return CrossfadeActive;
+}
+
+/*!	@brief Set a channel's output scale
+ *
+ *	@param[in] channel		Channel number
+ *	@param[in] scale		Output scale, 0xFF = full
+ *	@date 19.10.26			First implementation					*/
+void etheRgbDimmer_SetChannelScale(uint8_t channel, uint8_t scale)
+{
+	if (channel >= ETHERGB_MAX_OUTPUT_PINS)
+	{
+		LOG_EVENT(SRC_ETHERGB, LOG_EVT_DIMMER_INVALID_CHANNEL, channel);
+		return;
+	}
+
+	OutputScales[channel] = scale;
+	etheRgbDimmer_MarkChanged(channel);
+}
+
+/*!	@brief Set the master level, scaling all channels
+ *
+ *	@param[in] level		Master level, 0xFF = full, 0 = blackout
+ *	@param[in] duration		Fade duration in ms, 0 to set it at once
+ *	@date 19.10.26			First implementation					*/
+void etheRgbDimmer_SetMaster(uint8_t level, uint16_t duration)
+{
+	MasterStartLevel = MasterLevel;
+	MasterTargetLevel = level;
+	MasterStartTime = clockMillis();
+	MasterDuration = duration;
+	MasterLastPoll = MasterStartTime - 1;
+	MasterFading = true;
+
+	// Zero duration completes right away
+	etheRgbDimmer_PollMaster();
+}
+
+/*!	@brief Get the master level
+ *
+ *	@return uint8_t			Current master level
+ *	@date 19.10.26			First implementation					*/
+uint8_t etheRgbDimmer_GetMaster(void)
+{
+	return MasterLevel;
+}
@@ -3,22 +3,60 @@
  *	@author	inselc
  *	@date 11.07.17			First implementation
  *	@date 14.07.17			Rework
- *	@date 15.07.17			Rework									*/
+ *	@date 15.07.17			Rework
+ *	@date 19.10.26			Fade stop, value readback
+ *	@date 19.10.26			Configurable channel pins
+ *	@date 19.10.26			Channel count of the 74HC595 backend
+ *	@date 19.10.26			Channel count of the PCA9685 backend
+ *	@date 19.10.26			Timed crossfades
+ *	@date 19.10.26			Fade state readback
+ *	@date 19.10.26			Output scaling, for group submasters
+ *	@date 19.10.26			Master level							*/
 
 #ifndef ETHERGB_DIMMER_H_
 #define ETHERGB_DIMMER_H_
 
 /*!	@file */
+#include <stdint.h>
+#include <stdbool.h>
 #include "../../modules/io/io.h"
+#include "../../core/Dimmer/Dimmer.h"
 
+#if defined(DIMMER_FIXED_OUTPUTS)
+#define ETHERGB_MAX_OUTPUT_PINS DIMMER_MAX_CHANNELS
+#else
 #define ETHERGB_MAX_OUTPUT_PINS 8
-#define ETHERGB_MAX_GROUPS 2
+#endif
+#define ETHERGB_CHANNEL_MASK_BITS 8		/* Channels reachable by channel bit masks */
+
+/*!	@struct etheRgbDimmerPin_t
+ *	@brief Channel to pin assignment
+ *
+ *	A port of INPUT_PORT_NONE (or erased EEPROM) leaves the channel
+ *	without an output.
+ *
+ *	@date 19.10.26			First implementation					*/
+typedef struct __attribute__((packed)) {
+	uint8_t port;							//!< Output port (inputPort_t)
+	uint8_t number;							//!< Pin number at the port
+} etheRgbDimmerPin_t;
 
 void etheRgbDimmer_Init(void);
+bool etheRgbDimmer_GetOutputPin(uint8_t channel, etheRgbDimmerPin_t* pin);
+bool etheRgbDimmer_SetOutputPin(uint8_t channel, const etheRgbDimmerPin_t* pin);
+uint8_t etheRgbDimmer_GetOutputMask(uint8_t port);
 void etheRgbDimmer_Reset(void);
 void etheRgbDimmer_Poll(void);
 void etheRgbDimmer_SetChannelValue(uint8_t channel, uint8_t value);
 void etheRgbDimmer_SetChannelFadeSpeed(uint8_t channel, uint8_t speed);
 void etheRgbDimmer_SetChannelFadeValue(uint8_t channel, uint8_t value);
+void etheRgbDimmer_StopChannelFade(uint8_t channel);
+uint8_t etheRgbDimmer_GetChannelValue(uint8_t channel);
+bool etheRgbDimmer_IsChannelFading(uint8_t channel);
+void etheRgbDimmer_SetChannelScale(uint8_t channel, uint8_t scale);
+void etheRgbDimmer_SetMaster(uint8_t level, uint16_t duration);
+uint8_t etheRgbDimmer_GetMaster(void);
+void etheRgbDimmer_Crossfade(const uint8_t* values, uint16_t duration);
+bool etheRgbDimmer_IsCrossfading(void);
 
 #endif /* ETHERGB_DIMMER_H_ */
\ No newline at end of file
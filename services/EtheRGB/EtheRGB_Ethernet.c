@@ -4,7 +4,8 @@
  *	@date 21.05.17			First implementation
  *	@date 08.07.17			Reworked comms module
  *	@date 12.07.17			Restructuring
- *	@date 13.07.17			Added responses							*/
+ *	@date 13.07.17			Added responses
+ *	@date 19.10.26			Deferred logging on packet paths		*/
  
 #include <stdio.h>
 #include <stdint.h>
@@ -63,7 +64,7 @@ void etheRgbEthernet_Close(void)
 {
 	ethSockClose(ServerSocket);
 
-	LOG_MESSAGE(SRC_ETHERGB, "Ethernet Socket closed.");
+	LOG_EVENT(SRC_ETHERGB, LOG_EVT_ETH_SOCKET_CLOSED, ServerSocket);
 }
 
 /*!	@brief Ethernet Moudule Polling Function
@@ -82,19 +83,19 @@ etheRgbSource_t etheRgbEthernet_Poll(void)
 
 	if (ethIsClosed(ServerSocket))
 	{
-		LOG_MESSAGE(SRC_ETHERGB, "Socket closed. Reopening...");
+		LOG_EVENT(SRC_ETHERGB, LOG_EVT_ETH_SOCKET_REOPEN, ServerSocket);
 		if (!ethSockOpen(ServerSocket, ServerPort, W5100_Sn_MR_PROTO_TCP, 0))
 		{
 			LOG_CRASH(SRC_ETHERGB, "Could not open server socket.");
 		}
 		if (!ethSockListen(ServerSocket))
 		{
-			LOG_CRASH(SRC_ETHERGB, "Could not start listening on server socket.")
+			LOG_CRASH(SRC_ETHERGB, "Could not start listening on server socket.");
 		}
 	}
 	else if(ethIsClosing(ServerSocket))
 	{
-		LOG_MESSAGE(SRC_ETHERGB, "Socket closing. Disconnecting...");
+		LOG_EVENT(SRC_ETHERGB, LOG_EVT_ETH_SOCKET_DISCONNECT, ServerSocket);
 		ethSockDisconnect(ServerSocket);
 	}
 
@@ -107,7 +108,7 @@ etheRgbSource_t etheRgbEthernet_Poll(void)
 
 		if (dataLength < 3)
 		{
-			LOG_MESSAGE(SRC_ETHERGB, "Message too short.");
+			LOG_EVENT(SRC_ETHERGB, LOG_EVT_ETH_MESSAGE_TOO_SHORT, dataLength);
 			etheRgbEthernet_Close();
 			etheRgbEthernet_Reset();
 
@@ -118,7 +119,7 @@ etheRgbSource_t etheRgbEthernet_Poll(void)
 			// Check start byte
 			if (data[0] != ETHERGB_START_BYTE)
 			{
-				LOG_MESSAGE(SRC_ETHERGB, "Got invalid start byte.");
+				LOG_EVENT(SRC_ETHERGB, LOG_EVT_ETH_INVALID_START, data[0]);
 				etheRgbEthernet_Close();
 				etheRgbEthernet_Reset();
 
@@ -129,7 +130,7 @@ etheRgbSource_t etheRgbEthernet_Poll(void)
 			// Check command byte
 			if (!etheRgbCommand_HasCommand(data[1]))
 			{
-				LOG_MESSAGE(SRC_ETHERGB, "Got invalid command byte.");
+				LOG_EVENT(SRC_ETHERGB, LOG_EVT_ETH_INVALID_COMMAND, data[1]);
 				etheRgbEthernet_Close();
 				etheRgbEthernet_Reset();
 
@@ -143,7 +144,7 @@ etheRgbSource_t etheRgbEthernet_Poll(void)
 			uint8_t expectedDataLength = etheRgbCommand_GetRequiredDataLength(data[1]);
 			if (LocalCommandBuffer.dataLength > expectedDataLength)
 			{
-				LOG_MESSAGE(SRC_ETHERGB, "Data too long");
+				LOG_EVENT(SRC_ETHERGB, LOG_EVT_ETH_DATA_TOO_LONG, LocalCommandBuffer.dataLength);
 				etheRgbEthernet_Close();
 				etheRgbEthernet_Reset();
 
@@ -158,9 +159,10 @@ etheRgbSource_t etheRgbEthernet_Poll(void)
 			}
 
 			// Check checksum
-			if (data[2+LocalCommandBuffer.dataLength] != etheRgbCommand_CalculateChecksum(&LocalCommandBuffer))
+			uint8_t checksum = etheRgbCommand_CalculateChecksum(&LocalCommandBuffer);
+			if (data[2+LocalCommandBuffer.dataLength] != checksum)
 			{
-				LOG_MESSAGE(SRC_ETHERGB, "Got invalid checksum.");
+				LOG_EVENT(SRC_ETHERGB, LOG_EVT_ETH_INVALID_CHECKSUM, ((uint16_t)data[2+LocalCommandBuffer.dataLength] << 8) | checksum);
 				etheRgbEthernet_Close();
 				etheRgbEthernet_Reset();
 
@@ -191,7 +193,7 @@ etheRgbSource_t etheRgbEthernet_Poll(void)
 		{	
 			if (!ethIsListening(ServerSocket))
 			{
-				LOG_MESSAGE(SRC_ETHERGB, "Ethernet connection timed out.");
+				LOG_EVENT(SRC_ETHERGB, LOG_EVT_ETH_TIMEOUT, ServerSocket);
 				etheRgbEthernet_Close();
 				etheRgbEthernet_Reset();
 				return SOURCE_NONE;
@@ -0,0 +1,241 @@
+/*!	@brief EtheRGB Group module
+ *
+ *	The channel mapping is kept in EEPROM and read into RAM at start.
+ *	Group values are given for all roles at once (red, green, blue,
+ *	white, intensity) and resolved to channel values in one pass.
+ *	Without an intensity channel, the intensity scales the colors.
+ *
+ *	Submaster levels are not baked into the channel values: they set
+ *	the output scale of the group's channels in the dimmer, so scenes
+ *	and readback keep the unscaled values. A channel in more than one
+ *	group is scaled by all of their levels, multiplied; its scale is
+ *	recomputed from the groups whenever a level or a mapping changes.
+ *
+ *	@author	inselc
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Scales of channels in several groups	*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <avr/eeprom.h>
+#include "EtheRGB_Dimmer.h"
+#include "EtheRGB_Group.h"
+#include "EtheRGB_Config.h"
+
+static etheRgbGroupChannels_t GroupChannels[ETHERGB_MAX_GROUPS];	//!< Channel mapping
+static uint8_t GroupLevels[ETHERGB_MAX_GROUPS];						//!< Submaster levels
+
+/*!	@brief Check, if a group maps a channel
+ *
+ *	@param[in] group		Group number
+ *	@param[in] channel		Channel number
+ *	@return bool			true, if any role of the group uses the channel
+ *	@date 19.10.26			First implementation					*/
+static bool etheRgbGroup_HasChannel(uint8_t group, uint8_t channel)
+{
+	for (uint8_t role = 0; role < GROUP_ROLE_COUNT; ++role)
+	{
+		if (GroupChannels[group].channels[role] == channel)
+			return true;
+	}
+	return false;
+}
+
+/*!	@brief Recompute a channel's output scale from its groups
+ *
+ *	@param[in] channel		Channel number
+ *	@date 19.10.26			First implementation					*/
+static void etheRgbGroup_ApplyChannelScale(uint8_t channel)
+{
+	uint8_t scale = 0xFF;
+	for (uint8_t group = 0; group < ETHERGB_MAX_GROUPS; ++group)
+	{
+		if (etheRgbGroup_HasChannel(group, channel))
+			scale = ((uint16_t)scale * (GroupLevels[group] + 1)) >> 8;
+	}
+	etheRgbDimmer_SetChannelScale(channel, scale);
+}
+
+/*!	@brief Apply submaster levels to a group's channels
+ *
+ *	@param[in] *channels	Channels, by role
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Scales from all groups of a channel		*/
+static void etheRgbGroup_ApplyLevels(const etheRgbGroupChannels_t* channels)
+{
+	for (uint8_t role = 0; role < GROUP_ROLE_COUNT; ++role)
+	{
+		uint8_t channel = channels->channels[role];
+		if (channel != ETHERGB_GROUP_CHANNEL_NONE)
+			etheRgbGroup_ApplyChannelScale(channel);
+	}
+}
+
+/*!	@brief Resolve group values to channel values
+ *
+ *	@param[in] group		Group number
+ *	@param[in] *values		Red, green, blue, white, intensity
+ *	@param[out] *resolved	Channel values, by role
+ *	@date 19.10.26			First implementation					*/
+static void etheRgbGroup_Resolve(uint8_t group, const uint8_t* values, uint8_t* resolved)
+{
+	uint8_t intensity = values[GROUP_ROLE_INTENSITY];
+	bool scaleColors = (GroupChannels[group].channels[GROUP_ROLE_INTENSITY] == ETHERGB_GROUP_CHANNEL_NONE);
+
+	for (uint8_t role = 0; role < GROUP_ROLE_INTENSITY; ++role)
+	{
+		resolved[role] = scaleColors ?
+			((uint16_t)values[role] * (intensity + 1)) >> 8 :
+			values[role];
+	}
+	resolved[GROUP_ROLE_INTENSITY] = intensity;
+}
+
+/*!	@brief Initialize the group module
+ *
+ *	Loads the channel mapping from EEPROM. Channels out of bounds are
+ *	left out.
+ *
+ *	@date 19.10.26			First implementation					*/
+void etheRgbGroup_Init(void)
+{
+	eeprom_read_block(GroupChannels, EtheRgbGroups, sizeof(GroupChannels));
+
+	for (uint8_t group = 0; group < ETHERGB_MAX_GROUPS; ++group)
+	{
+		for (uint8_t role = 0; role < GROUP_ROLE_COUNT; ++role)
+		{
+			if (GroupChannels[group].channels[role] >= ETHERGB_MAX_OUTPUT_PINS)
+				GroupChannels[group].channels[role] = ETHERGB_GROUP_CHANNEL_NONE;
+		}
+		GroupLevels[group] = 0xFF;
+	}
+}
+
+/*!	@brief Read a group's channel mapping
+ *
+ *	@param[in] group		Group number
+ *	@param[out] *channels	Channels, by role
+ *	@return bool			false, if the group is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbGroup_GetChannels(uint8_t group, etheRgbGroupChannels_t* channels)
+{
+	if ((group >= ETHERGB_MAX_GROUPS) || (channels == NULL))
+		return false;
+
+	*channels = GroupChannels[group];
+	return true;
+}
+
+/*!	@brief Map channels to a group's roles
+ *
+ *	Takes effect immediately, and is written to EEPROM. Channels
+ *	leaving the group are no longer scaled by its submaster, but keep
+ *	the scale of their other groups.
+ *
+ *	@param[in] group		Group number
+ *	@param[in] *channels	Channels, by role
+ *	@return bool			false, if the group or a channel is out of
+ *							bounds
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Keep the scales of other groups			*/
+bool etheRgbGroup_SetChannels(uint8_t group, const etheRgbGroupChannels_t* channels)
+{
+	if ((group >= ETHERGB_MAX_GROUPS) || (channels == NULL))
+		return false;
+
+	for (uint8_t role = 0; role < GROUP_ROLE_COUNT; ++role)
+	{
+		uint8_t channel = channels->channels[role];
+		if ((channel != ETHERGB_GROUP_CHANNEL_NONE) && (channel >= ETHERGB_MAX_OUTPUT_PINS))
+			return false;
+	}
+
+	etheRgbGroupChannels_t previous = GroupChannels[group];
+	GroupChannels[group] = *channels;
+	etheRgbGroup_ApplyLevels(&previous);
+	etheRgbGroup_ApplyLevels(channels);
+
+	eeprom_update_block(channels, &EtheRgbGroups[group], sizeof(*channels));
+	return true;
+}
+
+/*!	@brief Set a group's values
+ *
+ *	@param[in] group		Group number
+ *	@param[in] *values		Red, green, blue, white, intensity
+ *	@return bool			false, if the group is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbGroup_Set(uint8_t group, const uint8_t* values)
+{
+	if (group >= ETHERGB_MAX_GROUPS)
+		return false;
+
+	uint8_t resolved[GROUP_ROLE_COUNT];
+	etheRgbGroup_Resolve(group, values, resolved);
+
+	for (uint8_t role = 0; role < GROUP_ROLE_COUNT; ++role)
+	{
+		uint8_t channel = GroupChannels[group].channels[role];
+		if (channel != ETHERGB_GROUP_CHANNEL_NONE)
+			etheRgbDimmer_SetChannelValue(channel, resolved[role]);
+	}
+	return true;
+}
+
+/*!	@brief Fade a group to new values
+ *
+ *	@param[in] group		Group number
+ *	@param[in] *values		Red, green, blue, white, intensity
+ *	@param[in] speed		Fading speed, as for a channel fade
+ *	@return bool			false, if the group is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbGroup_Fade(uint8_t group, const uint8_t* values, uint8_t speed)
+{
+	if (group >= ETHERGB_MAX_GROUPS)
+		return false;
+
+	uint8_t resolved[GROUP_ROLE_COUNT];
+	etheRgbGroup_Resolve(group, values, resolved);
+
+	for (uint8_t role = 0; role < GROUP_ROLE_COUNT; ++role)
+	{
+		uint8_t channel = GroupChannels[group].channels[role];
+		if (channel != ETHERGB_GROUP_CHANNEL_NONE)
+		{
+			etheRgbDimmer_SetChannelFadeSpeed(channel, speed);
+			etheRgbDimmer_SetChannelFadeValue(channel, resolved[role]);
+		}
+	}
+	return true;
+}
+
+/*!	@brief Set a group's submaster level
+ *
+ *	@param[in] group		Group number
+ *	@param[in] level		Submaster level, 0xFF = full
+ *	@return bool			false, if the group is out of bounds
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Scales from all groups of a channel		*/
+bool etheRgbGroup_SetLevel(uint8_t group, uint8_t level)
+{
+	if (group >= ETHERGB_MAX_GROUPS)
+		return false;
+
+	GroupLevels[group] = level;
+	etheRgbGroup_ApplyLevels(&GroupChannels[group]);
+	return true;
+}
+
+/*!	@brief Get a group's submaster level
+ *
+ *	@param[in] group		Group number
+ *	@return uint8_t			Submaster level, 0 if out of bounds
+ *	@date 19.10.26			First implementation					*/
+uint8_t etheRgbGroup_GetLevel(uint8_t group)
+{
+	if (group >= ETHERGB_MAX_GROUPS)
+		return 0;
+
+	return GroupLevels[group];
+}
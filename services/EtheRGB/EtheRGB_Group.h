@@ -0,0 +1,52 @@
+/*!	@brief EtheRGB Group module
+ *
+ *	Groups map any channels to the roles of a fixture (red, green,
+ *	blue, white, intensity), so a fixture is set or faded with a
+ *	single command. Every group has a submaster level scaling its
+ *	channels' outputs.
+ *
+ *	@author	inselc
+ *	@date 19.10.26			First implementation					*/
+
+#ifndef ETHERGB_GROUP_H_
+#define ETHERGB_GROUP_H_
+
+/*!	@file */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ETHERGB_MAX_GROUPS			8
+#define ETHERGB_GROUP_CHANNEL_NONE	0xFF	/* Role without a channel */
+
+/*!	@enum etheRgbGroupRole_t
+ *	@brief Channel roles in a group									*/
+typedef enum {
+	GROUP_ROLE_RED = 0,
+	GROUP_ROLE_GREEN = 1,
+	GROUP_ROLE_BLUE = 2,
+	GROUP_ROLE_WHITE = 3,
+	GROUP_ROLE_INTENSITY = 4,		//!< Without a channel, the colors are scaled instead
+	GROUP_ROLE_COUNT
+} etheRgbGroupRole_t;
+
+/*!	@struct etheRgbGroupChannels_t
+ *	@brief Channels of a group, by role
+ *
+ *	Roles with ETHERGB_GROUP_CHANNEL_NONE (or erased EEPROM) are
+ *	left out.
+ *
+ *	@date 19.10.26			First implementation					*/
+typedef struct __attribute__((packed)) {
+	uint8_t channels[GROUP_ROLE_COUNT];	//!< Channel, by etheRgbGroupRole_t
+} etheRgbGroupChannels_t;
+
+void etheRgbGroup_Init(void);
+bool etheRgbGroup_GetChannels(uint8_t group, etheRgbGroupChannels_t* channels);
+bool etheRgbGroup_SetChannels(uint8_t group, const etheRgbGroupChannels_t* channels);
+bool etheRgbGroup_Set(uint8_t group, const uint8_t* values);
+bool etheRgbGroup_Fade(uint8_t group, const uint8_t* values, uint8_t speed);
+bool etheRgbGroup_SetLevel(uint8_t group, uint8_t level);
+uint8_t etheRgbGroup_GetLevel(uint8_t group);
+
+#endif /* ETHERGB_GROUP_H_ */
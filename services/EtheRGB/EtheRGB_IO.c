@@ -2,44 +2,179 @@
  *
  *	Handles button inputs
  *
+ *	Edge triggers are evaluated from the debounced edge events queued
+ *	by the input module, so no edge is missed while the main loop is
+ *	busy elsewhere. Level triggers are sampled from the debounced
+ *	pin states, one pin per call, and repeat at most every
+ *	ETHERGB_IO_LEVEL_REPEAT_MS while the level holds.
+ *
+ *	Gesture triggers recognise clicks, double clicks and long presses
+ *	from the edge timestamps, and can ramp dimmer channels while a
+ *	button is held. A click is only reported after the double click
+ *	window has passed, unless no double click command is set.
+ *
+ *	Rotary encoders are decoded by the input module. The detents
+ *	accumulated since the last poll are applied to the mapped
+ *	channels as a single brightness change. Analog inputs only
+ *	update their channels when the analog module reports a change
+ *	past its hysteresis.
+ *
+ *	Infrared remote key codes are looked up in the key table, which
+ *	is only held in EEPROM to save RAM. Repeated frames of a held key
+ *	only run the command if the key's repeat flag is set.
+ *
  *	@author	inselc
  *	@date 10.07.17		First implementation
- *	@date 11.07.17		Restructuring								*/
+ *	@date 11.07.17		Restructuring
+ *	@date 19.10.26		Edge triggers from pin change events
+ *	@date 19.10.26		Debounced inputs
+ *	@date 19.10.26		Gestures, level trigger rate limit
+ *	@date 19.10.26		Configuration records, EEPROM persistence
+ *	@date 19.10.26		Rotary encoders
+ *	@date 19.10.26		Analog inputs
+ *	@date 19.10.26		Infrared remote keys
+ *	@date 19.10.26		Pin availability for dimmer outputs
+ *	@date 19.10.26		TWI pins of the PCA9685 backend
+ *	@date 19.10.26		Pixel strip data pin
+ *	@date 19.10.26		Zero-cross input of the phase-cut backend	*/
 
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
+#include <stddef.h>
+#include <avr/eeprom.h>
 #include "../../core/Serial/Serial.h"
 #include "../../core/Log/Log.h"
+#include "../../core/Input/Input.h"
+#include "../../core/Pixel/Pixel.h"
+#include "../../core/Analog/Analog.h"
+#include "../../core/IR/IR.h"
+#include "../../core/Clock/Clock.h"
 #include "../../modules/io/io.h"
 #include "EtheRGB_Command.h"
+#include "EtheRGB_Dimmer.h"
 #include "EtheRGB_IO.h"
+#include "EtheRGB_Config.h"
+
+/*!	@brief Pins used by the device itself, by port: IR receiver
+ *	(PB0), SPI to the W5100 (PB2..5), USART (PD0..1), XCK (PD4)
+ *	and latch (PD7) of the 74HC595 backend, SDA (PC4) and SCL (PC5)
+ *	of the PCA9685 backend, the zero-cross input (PD2) of the
+ *	phase-cut backend, and the pixel strip data (PB1). Dimmer outputs
+ *	are configurable, see etheRgbDimmer_GetOutputMask.				*/
+static const uint8_t ReservedPins[INPUT_PORT_COUNT] = {
+#if PIXEL_ENABLED
+	0x3F,
+#else
+	0x3D,
+#endif
+#if defined(CONF_DIMMER_USE_PCA9685)
+	0x30,
+#else
+	0x00,
+#endif
+#if defined(CONF_DIMMER_USE_HC595)
+	0x93
+#elif defined(CONF_DIMMER_USE_PHASE)
+	0x07
+#else
+	0x03
+#endif
+};
 
-#define ETHERGB_MAX_COMMAND_PINS 4
-#define ETHERGB_IO_PIN_LAST_STATE 1
-#define ETHERGB_IO_PIN_CURRENT_STATE 0
+/*!	@enum etheRgbIoGestureState_t
+ *	@brief Gesture recognition states
+ *
+ *	@date 19.10.26			First implementation					*/
+typedef enum {
+	GESTURE_STATE_IDLE,			//!< Button released
+	GESTURE_STATE_PRESSED,		//!< First press, not yet long
+	GESTURE_STATE_RELEASED,		//!< Short press, waiting for a second one
+	GESTURE_STATE_HELD,			//!< Long press, waiting for release
+	GESTURE_STATE_SECOND		//!< Second press, waiting for release
+} etheRgbIoGestureState_t;
 
-static etheRgbPinIoCommandMapping_t PinCommandMap[ETHERGB_MAX_COMMAND_PINS] = {{NULL, TRIGGER_NONE, ETHERGB_INVALID_COMMAND, {0}, 0, 0}};
+static etheRgbPinIoCommandMapping_t PinCommandMap[ETHERGB_MAX_COMMAND_PINS] = {{NULL, TRIGGER_NONE}};
+static pin_t ConfiguredPins[ETHERGB_MAX_COMMAND_PINS];	//!< Pin descriptions of configured entries
+static etheRgbIoEncoderConfig_t EncoderMap[ETHERGB_MAX_ENCODERS] = {
+	[0 ... ETHERGB_MAX_ENCODERS - 1] = { .port = INPUT_PORT_NONE }
+};
+static pin_t EncoderPins[ETHERGB_MAX_ENCODERS][2];		//!< Pin descriptions of encoders (A, B)
+static etheRgbIoAnalogConfig_t AnalogMap[ETHERGB_MAX_ANALOG_INPUTS] = {
+	[0 ... ETHERGB_MAX_ANALOG_INPUTS - 1] = { .input = ETHERGB_IO_ANALOG_NONE }
+};
+static irCode_t LastIrCode = { IR_PROTOCOL_NONE };	//!< Last received key code, for learning
 static etheRgbCommand_t* SharedCommandBuffer = NULL;
-static uint8_t PinCommandMapIndex = 0;
+static uint8_t PinCommandMapIndex = 0;		//!< Next pin to sample for level triggers
+static inputEvent_t PendingEvent;			//!< Event currently being evaluated
+static uint8_t PendingEventIndex = ETHERGB_MAX_COMMAND_PINS;	//!< Next mapping to check against PendingEvent
 
 /*!	@brief Initialize the I/O module
  *
  *	@param[in] *commandBuffer	Shared command buffer
- *	@date 11.07.17			Restructuring							*/
+ *	@date 11.07.17			Restructuring
+ *	@date 19.10.26			Load mappings from EEPROM
+ *	@date 19.10.26			Analog inputs
+ *	@date 19.10.26			Infrared receiver						*/
 void etheRgbIO_Init(etheRgbCommand_t* commandBuffer)
 {
 	SharedCommandBuffer = commandBuffer;
+	inputInit();
+	analogInit();
+	irInit();
+	etheRgbIO_LoadConfig();
 	etheRgbIO_Reset();
 }
 
 /*!	@brief Reset the I/O module
  *
- *	Resets the command map array index to 0
+ *	Resets the command map array index to 0 and drops the event
+ *	currently being evaluated
  *
- *	@date 11.07.17			First implementation					*/
+ *	@date 11.07.17			First implementation
+ *	@date 19.10.26			Reset pending event						*/
 void etheRgbIO_Reset(void)
 {
 	PinCommandMapIndex = 0;
+	PendingEventIndex = ETHERGB_MAX_COMMAND_PINS;
+}
+
+/*!	@brief Check, if two pin descriptions refer to the same pin
+ *
+ *	Every mapping entry has its own pin description, so entries on
+ *	the same pin are compared by port and number.
+ *
+ *	@param[in] *a			Input pin
+ *	@param[in] *b			Input pin
+ *	@return bool			true, if both are the same physical pin
+ *	@date 19.10.26			First implementation					*/
+static bool etheRgbIO_IsSamePin(pin_t* a, pin_t* b)
+{
+	if (a == NULL || b == NULL)
+		return false;
+
+	return (inputGetPort(a) == inputGetPort(b)) && (a->Number == b->Number);
+}
+
+/*!	@brief Enable debouncing for a pin, if any mapping uses it
+ *
+ *	@param[in] *pin			Input pin
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Compare physical pins					*/
+static void etheRgbIO_UpdateInput(pin_t* pin)
+{
+	if (pin == NULL)
+		return;
+
+	for (uint8_t i = 0; i < ETHERGB_MAX_COMMAND_PINS; ++i)
+	{
+		if (etheRgbIO_IsSamePin(PinCommandMap[i].pin, pin) && (PinCommandMap[i].trigger != TRIGGER_NONE))
+		{
+			inputEnablePin(pin);
+			return;
+		}
+	}
+	inputDisablePin(pin);
 }
 
 /*!	@brief Change a pin-command-mapping entry
@@ -48,7 +183,9 @@ void etheRgbIO_Reset(void)
  *	@param[in] *pin			Input pin
  *	@param[in] trigger		Pin trigger mode
  *	@param[in] *command		Command to be executed when pin triggers
- *	@date 14.07.17			First implementation					*/
+ *							(click command for gesture triggers)
+ *	@date 14.07.17			First implementation
+ *	@date 19.10.26			Gesture command slots					*/
 void etheRgbIO_SetupMapping(uint8_t index, pin_t* pin, etheRgbIoTrigger_t trigger, etheRgbCommand_t* command)
 {
 	if (index >= ETHERGB_MAX_COMMAND_PINS)
@@ -62,17 +199,17 @@ void etheRgbIO_SetupMapping(uint8_t index, pin_t* pin, etheRgbIoTrigger_t trigge
 		return;
 	}
 
+	pin_t* previousPin = PinCommandMap[index].pin;
 	PinCommandMap[index].pin = pin;
 	PinCommandMap[index].trigger = trigger;
-	if (command != NULL && command->commandType != ETHERGB_INVALID_COMMAND)
+	PinCommandMap[index].gestureState = GESTURE_STATE_IDLE;
+	if (command->commandType != ETHERGB_INVALID_COMMAND)
 	{
-		PinCommandMap[index].command = command->commandType;
-		PinCommandMap[index].dataLength = command->dataLength;
-		for (int i = 0; i < command->dataLength; ++i)
-		{
-			PinCommandMap[index].data[i] = command->data[i];
-		}
+		etheRgbIO_SetupGesture(index, GESTURE_CLICK, command);
 	}
+
+	etheRgbIO_UpdateInput(previousPin);
+	etheRgbIO_UpdateInput(pin);
 }
 
 /*!	@brief Read a pin-command-mapping entry
@@ -80,37 +217,766 @@ void etheRgbIO_SetupMapping(uint8_t index, pin_t* pin, etheRgbIoTrigger_t trigge
  *	@param[in] index		Entry index in mapping array
  *	@param[out] **pin		Input pin
  *	@param[out] *trigger	Pin trigger mode
- *	@param[out]	*command	Command buffer
- *	@date 14.07.17			First implementation					*/
+ *	@param[out]	*command	Command buffer (click command)
+ *	@date 14.07.17			First implementation
+ *	@date 19.10.26			Gesture command slots
+ *	@date 19.10.26			Fixed bounds and argument checks		*/
 void etheRgbIO_GetMapping(uint8_t index, pin_t** pin, etheRgbIoTrigger_t* trigger, etheRgbCommand_t* command)
 {
-	if (index > ETHERGB_MAX_COMMAND_PINS)
+	if (index >= ETHERGB_MAX_COMMAND_PINS)
 	{
 		LOG_ERROR(SRC_ETHERGB, "Index out of bounds.");
 		return;
 	}
-	if (pin == NULL || *pin == NULL || trigger == NULL || command == NULL)
+	if (pin == NULL || trigger == NULL || command == NULL)
 	{
 		LOG_ERROR(SRC_ETHERGB, "Invalid argument.");
+		return;
 	}
 
 	*pin = PinCommandMap[index].pin;
 	*trigger = PinCommandMap[index].trigger;
 	command->source = SOURCE_IO;
-	command->commandType = PinCommandMap[index].command;
-	command->dataLength = PinCommandMap[index].dataLength;
-	for (int i = 0; i < PinCommandMap[index].dataLength; ++i)
+	command->commandType = PinCommandMap[index].commands[GESTURE_CLICK].command;
+	command->dataLength = PinCommandMap[index].commands[GESTURE_CLICK].dataLength;
+	for (int i = 0; i < PinCommandMap[index].commands[GESTURE_CLICK].dataLength; ++i)
 	{
-		command->data[i] = PinCommandMap[index].data[i];
+		command->data[i] = PinCommandMap[index].commands[GESTURE_CLICK].data[i];
 	}	
 }
 
+/*!	@brief Change the command of a gesture slot
+ *
+ *	@param[in] index		Entry index in mapping array
+ *	@param[in] gesture		Gesture slot
+ *	@param[in] *command		Command to be executed, or an invalid
+ *							command to clear the slot
+ *	@date 19.10.26			First implementation					*/
+void etheRgbIO_SetupGesture(uint8_t index, etheRgbIoGesture_t gesture, etheRgbCommand_t* command)
+{
+	if (index >= ETHERGB_MAX_COMMAND_PINS || gesture >= ETHERGB_IO_GESTURE_COUNT)
+	{
+		LOG_ERROR(SRC_ETHERGB, "Index out of bounds.");
+		return;
+	}
+	if (command == NULL)
+	{
+		LOG_ERROR(SRC_ETHERGB, "Command arg is NULL.");
+		return;
+	}
+
+	etheRgbIoCommand_t* slot = &PinCommandMap[index].commands[gesture];
+	slot->command = command->commandType;
+	slot->dataLength = (command->dataLength < ETHERGB_IO_MAX_DATA_LENGTH) ? command->dataLength : ETHERGB_IO_MAX_DATA_LENGTH;
+	for (int i = 0; i < slot->dataLength; ++i)
+	{
+		slot->data[i] = command->data[i];
+	}
+}
+
+/*!	@brief Configure the channels ramped while a gesture button is held
+ *
+ *	@param[in] index		Entry index in mapping array
+ *	@param[in] channels		Channel bit mask, 0 to disable
+ *	@param[in] speed		Fading speed
+ *	@date 19.10.26			First implementation					*/
+void etheRgbIO_SetupRamp(uint8_t index, uint8_t channels, uint8_t speed)
+{
+	if (index >= ETHERGB_MAX_COMMAND_PINS)
+	{
+		LOG_ERROR(SRC_ETHERGB, "Index out of bounds.");
+		return;
+	}
+
+	PinCommandMap[index].rampChannels = channels;
+	PinCommandMap[index].rampSpeed = speed;
+	PinCommandMap[index].rampUp = true;
+}
+
+/*!	@brief Check pins against the device's and the dimmer's pins
+ *
+ *	@param[in] port			Port (inputPort_t)
+ *	@param[in] mask			Pin bit mask
+ *	@return bool			true, if any of the pins is taken
+ *	@date 19.10.26			First implementation					*/
+static bool etheRgbIO_IsReserved(uint8_t port, uint8_t mask)
+{
+	return ((ReservedPins[port] | etheRgbDimmer_GetOutputMask(port)) & mask) != 0;
+}
+
+/*!	@brief Check pins against the input mappings
+ *
+ *	@param[in] port			Port (inputPort_t)
+ *	@param[in] mask			Pin bit mask
+ *	@param[in] encoder		Encoder to leave out, or ETHERGB_MAX_ENCODERS
+ *	@return bool			true, if a pin mapping, encoder or analog
+ *							input uses any of the pins
+ *	@date 19.10.26			Moved from etheRgbIO_IsPinFree			*/
+static bool etheRgbIO_IsMapped(uint8_t port, uint8_t mask, uint8_t encoder)
+{
+	for (uint8_t i = 0; i < ETHERGB_MAX_COMMAND_PINS; ++i)
+	{
+		pin_t* pin = PinCommandMap[i].pin;
+		if ((pin != NULL) && (inputGetPort(pin) == port) && ((1 << pin->Number) & mask))
+			return true;
+	}
+	for (uint8_t i = 0; i < ETHERGB_MAX_ENCODERS; ++i)
+	{
+		if ((i != encoder) && (EncoderMap[i].port == port) &&
+			(((1 << EncoderMap[i].numberA) | (1 << EncoderMap[i].numberB)) & mask))
+			return true;
+	}
+	for (uint8_t i = 0; i < ETHERGB_MAX_ANALOG_INPUTS; ++i)
+	{
+		if ((port == INPUT_PORT_C) && (AnalogMap[i].input < 8) && ((1 << AnalogMap[i].input) & mask))
+			return true;
+	}
+	return false;
+}
+
+/*!	@brief Read a mapping entry in its stored form
+ *
+ *	@param[in] index		Entry index in mapping array
+ *	@param[out] *config		Configuration record
+ *	@return bool			false, if the index is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbIO_GetConfig(uint8_t index, etheRgbIoConfig_t* config)
+{
+	if (index >= ETHERGB_MAX_COMMAND_PINS || config == NULL)
+		return false;
+
+	etheRgbPinIoCommandMapping_t* mapping = &PinCommandMap[index];
+	config->port = inputGetPort(mapping->pin);
+	config->number = (mapping->pin != NULL) ? mapping->pin->Number : 0;
+	config->flags = (mapping->pin != NULL && mapping->pin->PullUp) ? ETHERGB_IO_FLAG_PULLUP : 0;
+	config->trigger = mapping->trigger;
+	memcpy(config->commands, mapping->commands, sizeof(config->commands));
+	config->rampChannels = mapping->rampChannels;
+	config->rampSpeed = mapping->rampSpeed;
+	return true;
+}
+
+/*!	@brief Change a mapping entry from its stored form
+ *
+ *	The entry's pin is set up as an input. Pins in use by the
+ *	device itself or as dimmer outputs are rejected.
+ *
+ *	@param[in] index		Entry index in mapping array
+ *	@param[in] *config		Configuration record
+ *	@return bool			false, if the record is invalid
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbIO_SetConfig(uint8_t index, const etheRgbIoConfig_t* config)
+{
+	if (index >= ETHERGB_MAX_COMMAND_PINS || config == NULL)
+		return false;
+
+	pin_t* pin = NULL;
+	etheRgbIoTrigger_t trigger = TRIGGER_NONE;
+
+	if (config->port != INPUT_PORT_NONE)
+	{
+		if ((config->port >= INPUT_PORT_COUNT) || (config->number > 7) ||
+			etheRgbIO_IsReserved(config->port, 1 << config->number) ||
+			(config->trigger > TRIGGER_GESTURE_LOW))
+			return false;
+
+		for (uint8_t i = 0; i < ETHERGB_IO_GESTURE_COUNT; ++i)
+		{
+			if ((config->commands[i].dataLength > ETHERGB_IO_MAX_DATA_LENGTH) ||
+				((config->commands[i].command != ETHERGB_INVALID_COMMAND) &&
+				 !etheRgbCommand_HasCommand(config->commands[i].command)))
+				return false;
+		}
+
+		pin = &ConfiguredPins[index];
+		trigger = config->trigger;
+	}
+
+	// Detach the entry before its pin description changes
+	pin_t* previousPin = PinCommandMap[index].pin;
+	PinCommandMap[index].pin = NULL;
+	PinCommandMap[index].trigger = TRIGGER_NONE;
+	etheRgbIO_UpdateInput(previousPin);
+
+	if (pin != NULL)
+	{
+		inputMakePin(pin, config->port, config->number, config->flags & ETHERGB_IO_FLAG_PULLUP);
+		ioInitPin(pin);
+	}
+
+	PinCommandMap[index].pin = pin;
+	PinCommandMap[index].trigger = trigger;
+	PinCommandMap[index].gestureState = GESTURE_STATE_IDLE;
+	memcpy(PinCommandMap[index].commands, config->commands, sizeof(config->commands));
+	PinCommandMap[index].rampChannels = config->rampChannels;
+	PinCommandMap[index].rampSpeed = config->rampSpeed;
+	PinCommandMap[index].rampUp = true;
+	etheRgbIO_UpdateInput(pin);
+	return true;
+}
+
+/*!	@brief Read a rotary encoder mapping
+ *
+ *	@param[in] index		Encoder index
+ *	@param[out] *config		Encoder mapping
+ *	@return bool			false, if the index is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbIO_GetEncoderConfig(uint8_t index, etheRgbIoEncoderConfig_t* config)
+{
+	if (index >= ETHERGB_MAX_ENCODERS || config == NULL)
+		return false;
+
+	*config = EncoderMap[index];
+	return true;
+}
+
+/*!	@brief Change a rotary encoder mapping
+ *
+ *	Both pins have to be different, and free of the device, dimmer
+ *	outputs, other encoders, pin mappings and analog inputs.
+ *
+ *	@param[in] index		Encoder index
+ *	@param[in] *config		Encoder mapping
+ *	@return bool			false, if the mapping is invalid
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Reject pins in use						*/
+bool etheRgbIO_SetEncoderConfig(uint8_t index, const etheRgbIoEncoderConfig_t* config)
+{
+	if (index >= ETHERGB_MAX_ENCODERS || config == NULL)
+		return false;
+
+	if (config->port != INPUT_PORT_NONE)
+	{
+		if ((config->port >= INPUT_PORT_COUNT) || (config->numberA > 7) || (config->numberB > 7) ||
+			(config->numberA == config->numberB))
+			return false;
+
+		uint8_t mask = (1 << config->numberA) | (1 << config->numberB);
+		if (etheRgbIO_IsReserved(config->port, mask) || etheRgbIO_IsMapped(config->port, mask, index))
+			return false;
+	}
+
+	inputDisableEncoder(index);
+	EncoderMap[index] = *config;
+
+	if (config->port == INPUT_PORT_NONE)
+		return true;
+
+	bool pullUp = config->flags & ETHERGB_IO_FLAG_PULLUP;
+	inputMakePin(&EncoderPins[index][0], config->port, config->numberA, pullUp);
+	inputMakePin(&EncoderPins[index][1], config->port, config->numberB, pullUp);
+	ioInitPin(&EncoderPins[index][0]);
+	ioInitPin(&EncoderPins[index][1]);
+
+	if (!inputEnableEncoder(index, &EncoderPins[index][0], &EncoderPins[index][1]))
+	{
+		EncoderMap[index].port = INPUT_PORT_NONE;
+		return false;
+	}
+	return true;
+}
+
+/*!	@brief Read an analog input mapping
+ *
+ *	@param[in] index		Analog input index
+ *	@param[out] *config		Analog input mapping
+ *	@return bool			false, if the index is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbIO_GetAnalogConfig(uint8_t index, etheRgbIoAnalogConfig_t* config)
+{
+	if (index >= ETHERGB_MAX_ANALOG_INPUTS || config == NULL)
+		return false;
+
+	*config = AnalogMap[index];
+	return true;
+}
+
+/*!	@brief Change an analog input mapping
+ *
+ *	@param[in] index		Analog input index
+ *	@param[in] *config		Analog input mapping
+ *	@return bool			false, if the mapping is invalid
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbIO_SetAnalogConfig(uint8_t index, const etheRgbIoAnalogConfig_t* config)
+{
+	if (index >= ETHERGB_MAX_ANALOG_INPUTS || config == NULL)
+		return false;
+	if ((config->input != ETHERGB_IO_ANALOG_NONE) && (config->input >= ANALOG_MAX_CHANNELS))
+		return false;
+	if ((config->input < 6) && etheRgbIO_IsReserved(INPUT_PORT_C, 1 << config->input))
+		return false;
+
+	uint8_t previousInput = AnalogMap[index].input;
+	AnalogMap[index] = *config;
+
+	// Stop converting inputs no other entry uses
+	if (previousInput != ETHERGB_IO_ANALOG_NONE)
+	{
+		bool used = false;
+		for (uint8_t i = 0; i < ETHERGB_MAX_ANALOG_INPUTS; ++i)
+		{
+			used |= (AnalogMap[i].input == previousInput);
+		}
+		if (!used)
+			analogDisableChannel(previousInput);
+	}
+
+	if ((config->input != ETHERGB_IO_ANALOG_NONE) && (config->input != previousInput))
+	{
+		// ADC0..5 share PORTC, make sure the pin is a plain input
+		if (config->input < 6)
+		{
+			pin_t pin;
+			inputMakePin(&pin, INPUT_PORT_C, config->input, false);
+			ioInitPin(&pin);
+		}
+		analogEnableChannel(config->input);
+	}
+	return true;
+}
+
+/*!	@brief Read an infrared remote key mapping
+ *
+ *	@param[in] index		Key index
+ *	@param[out] *key		Key mapping
+ *	@return bool			false, if the index is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbIO_GetIrKey(uint8_t index, etheRgbIoIrKey_t* key)
+{
+	if (index >= ETHERGB_MAX_IR_KEYS || key == NULL)
+		return false;
+
+	eeprom_read_block(key, &EtheRgbIoIrKeys[index], sizeof(*key));
+	return true;
+}
+
+/*!	@brief Change an infrared remote key mapping
+ *
+ *	Key mappings are written to EEPROM directly. Unknown commands,
+ *	and commands with less data than they require, are rejected.
+ *
+ *	@param[in] index		Key index
+ *	@param[in] *key			Key mapping
+ *	@return bool			false, if the mapping is invalid
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Check the command						*/
+bool etheRgbIO_SetIrKey(uint8_t index, const etheRgbIoIrKey_t* key)
+{
+	if (index >= ETHERGB_MAX_IR_KEYS || key == NULL)
+		return false;
+	if ((key->protocol != IR_PROTOCOL_NONE) && (key->protocol != IR_PROTOCOL_NEC) && (key->protocol != IR_PROTOCOL_RC5))
+		return false;
+	if (key->command.dataLength > ETHERGB_IO_MAX_DATA_LENGTH)
+		return false;
+	if ((key->command.command != ETHERGB_INVALID_COMMAND) &&
+		(!etheRgbCommand_HasCommand(key->command.command) ||
+		 (etheRgbCommand_GetRequiredDataLength(key->command.command) > key->command.dataLength)))
+		return false;
+
+	eeprom_update_block(key, &EtheRgbIoIrKeys[index], sizeof(*key));
+	return true;
+}
+
+/*!	@brief Get the last received infrared key code
+ *
+ *	Meant for learning the codes of a remote.
+ *
+ *	@param[out] *code		Key code
+ *	@return bool			false, if no code has been received
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbIO_GetLastIrCode(irCode_t* code)
+{
+	if (code == NULL || LastIrCode.protocol == IR_PROTOCOL_NONE)
+		return false;
+
+	*code = LastIrCode;
+	return true;
+}
+
+/*!	@brief Check whether a pin is free for use as an output
+ *
+ *	@param[in] port			Port (inputPort_t)
+ *	@param[in] number		Pin number at the port
+ *	@return bool			false, if the device or an input mapping
+ *							uses the pin
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Mapping check moved to etheRgbIO_IsMapped	*/
+bool etheRgbIO_IsPinFree(uint8_t port, uint8_t number)
+{
+	if ((port >= INPUT_PORT_COUNT) || (number > 7))
+		return false;
+
+	uint8_t mask = 1 << number;
+	if (ReservedPins[port] & mask)
+		return false;
+
+	return !etheRgbIO_IsMapped(port, mask, ETHERGB_MAX_ENCODERS);
+}
+
+/*!	@brief Load all mapping entries from EEPROM
+ *
+ *	Invalid or erased records leave their entry unused.
+ *
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Rotary encoders
+ *	@date 19.10.26			Analog inputs							*/
+void etheRgbIO_LoadConfig(void)
+{
+	etheRgbIoConfig_t config;
+	etheRgbIoEncoderConfig_t encoderConfig;
+	etheRgbIoAnalogConfig_t analogConfig;
+
+	for (uint8_t i = 0; i < ETHERGB_MAX_COMMAND_PINS; ++i)
+	{
+		eeprom_read_block(&config, &EtheRgbIoConfig[i], sizeof(config));
+		if (!etheRgbIO_SetConfig(i, &config))
+		{
+			config.port = INPUT_PORT_NONE;
+			etheRgbIO_SetConfig(i, &config);
+		}
+	}
+
+	for (uint8_t i = 0; i < ETHERGB_MAX_ENCODERS; ++i)
+	{
+		eeprom_read_block(&encoderConfig, &EtheRgbIoEncoderConfig[i], sizeof(encoderConfig));
+		if (!etheRgbIO_SetEncoderConfig(i, &encoderConfig))
+		{
+			encoderConfig.port = INPUT_PORT_NONE;
+			etheRgbIO_SetEncoderConfig(i, &encoderConfig);
+		}
+	}
+
+	for (uint8_t i = 0; i < ETHERGB_MAX_ANALOG_INPUTS; ++i)
+	{
+		eeprom_read_block(&analogConfig, &EtheRgbIoAnalogConfig[i], sizeof(analogConfig));
+		if (!etheRgbIO_SetAnalogConfig(i, &analogConfig))
+		{
+			analogConfig.input = ETHERGB_IO_ANALOG_NONE;
+			etheRgbIO_SetAnalogConfig(i, &analogConfig);
+		}
+	}
+}
+
+/*!	@brief Store all mapping entries in EEPROM
+ *
+ *	Only bytes that changed are written.
+ *
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Rotary encoders							*/
+void etheRgbIO_SaveConfig(void)
+{
+	etheRgbIoConfig_t config;
+
+	for (uint8_t i = 0; i < ETHERGB_MAX_COMMAND_PINS; ++i)
+	{
+		etheRgbIO_GetConfig(i, &config);
+		eeprom_update_block(&config, &EtheRgbIoConfig[i], sizeof(config));
+	}
+
+	eeprom_update_block(EncoderMap, EtheRgbIoEncoderConfig, sizeof(EncoderMap));
+	eeprom_update_block(AnalogMap, EtheRgbIoAnalogConfig, sizeof(AnalogMap));
+}
+
+/*!	@brief Look up received infrared key codes
+ *
+ *	Loads the command of the first mapped key into the shared
+ *	command buffer; codes received after it stay queued.
+ *
+ *	@return bool			true, if a command was loaded
+ *	@date 19.10.26			First implementation					*/
+static bool etheRgbIO_PollIr(void)
+{
+	irCode_t code;
+	etheRgbIoIrKey_t key;
+
+	while (irGetCode(&code))
+	{
+		LastIrCode = code;
+
+		for (uint8_t i = 0; i < ETHERGB_MAX_IR_KEYS; ++i)
+		{
+			// Compare the key header before reading the command
+			eeprom_read_block(&key, &EtheRgbIoIrKeys[i], offsetof(etheRgbIoIrKey_t, command));
+			if ((key.protocol != code.protocol) || (key.address != code.address) || (key.code != code.command))
+				continue;
+			if (code.repeat && !(key.flags & ETHERGB_IO_FLAG_REPEAT))
+				break;
+
+			eeprom_read_block(&key.command, &EtheRgbIoIrKeys[i].command, sizeof(key.command));
+			if (key.command.command == ETHERGB_INVALID_COMMAND || key.command.dataLength > ETHERGB_IO_MAX_DATA_LENGTH)
+				break;
+
+			SharedCommandBuffer->commandType = key.command.command;
+			for (int j=0; j < ETHERGB_IO_MAX_DATA_LENGTH; ++j)
+			{
+				SharedCommandBuffer->data[j] = key.command.data[j];
+			}
+			SharedCommandBuffer->dataLength = key.command.dataLength;
+			SharedCommandBuffer->source = SOURCE_IO;
+			return true;
+		}
+	}
+	return false;
+}
+
+/*!	@brief Apply changed analog inputs to their channels
+ *
+ *	@date 19.10.26			First implementation					*/
+static void etheRgbIO_PollAnalog(void)
+{
+	uint8_t changed = analogGetChanged();
+	if (changed == 0)
+		return;
+
+	for (uint8_t i = 0; i < ETHERGB_MAX_ANALOG_INPUTS; ++i)
+	{
+		uint8_t input = AnalogMap[i].input;
+		if ((input == ETHERGB_IO_ANALOG_NONE) || ((changed & (1 << input)) == 0))
+			continue;
+
+		// 10 bit input to 8 bit level
+		uint8_t level = analogRead(input) >> 2;
+		if (AnalogMap[i].flags & ETHERGB_IO_FLAG_INVERT)
+			level = 0xFF - level;
+
+		for (uint8_t channel = 0; channel < ETHERGB_CHANNEL_MASK_BITS; ++channel)
+		{
+			if (AnalogMap[i].channels & (1 << channel))
+				etheRgbDimmer_SetChannelValue(channel, level);
+		}
+	}
+}
+
+/*!	@brief Apply the detents of all encoders to their channels
+ *
+ *	@date 19.10.26			First implementation					*/
+static void etheRgbIO_PollEncoders(void)
+{
+	for (uint8_t i = 0; i < ETHERGB_MAX_ENCODERS; ++i)
+	{
+		if (EncoderMap[i].port == INPUT_PORT_NONE)
+			continue;
+
+		int8_t detents = inputGetEncoderDetents(i);
+		if (detents == 0)
+			continue;
+
+		int16_t delta = (int16_t)detents * EncoderMap[i].stepSize;
+		for (uint8_t channel = 0; channel < ETHERGB_CHANNEL_MASK_BITS; ++channel)
+		{
+			if ((EncoderMap[i].channels & (1 << channel)) == 0)
+				continue;
+
+			int16_t value = etheRgbDimmer_GetChannelValue(channel) + delta;
+			if (value < 0x00)
+				value = 0x00;
+			else if (value > 0xFF)
+				value = 0xFF;
+			etheRgbDimmer_SetChannelValue(channel, (uint8_t)value);
+		}
+	}
+}
+
+/*!	@brief Start fading the ramp channels of a mapping
+ *
+ *	The direction alternates with every hold, and turns around at
+ *	either end of the brightness range.
+ *
+ *	@param[in] *mapping		Pin-command-mapping entry
+ *	@date 19.10.26			First implementation					*/
+static void etheRgbIO_StartRamp(etheRgbPinIoCommandMapping_t* mapping)
+{
+	bool directionSet = false;
+
+	for (uint8_t channel = 0; channel < ETHERGB_CHANNEL_MASK_BITS; ++channel)
+	{
+		if ((mapping->rampChannels & (1 << channel)) == 0)
+			continue;
+
+		if (!directionSet)
+		{
+			uint8_t value = etheRgbDimmer_GetChannelValue(channel);
+			if (value == 0xFF)
+				mapping->rampUp = false;
+			else if (value == 0x00)
+				mapping->rampUp = true;
+			directionSet = true;
+		}
+
+		etheRgbDimmer_SetChannelFadeSpeed(channel, mapping->rampSpeed);
+		etheRgbDimmer_SetChannelFadeValue(channel, mapping->rampUp ? 0xFF : 0x00);
+	}
+}
+
+/*!	@brief Stop the ramp of a mapping at the current brightness
+ *
+ *	@param[in] *mapping		Pin-command-mapping entry
+ *	@date 19.10.26			First implementation					*/
+static void etheRgbIO_StopRamp(etheRgbPinIoCommandMapping_t* mapping)
+{
+	for (uint8_t channel = 0; channel < ETHERGB_CHANNEL_MASK_BITS; ++channel)
+	{
+		if (mapping->rampChannels & (1 << channel))
+			etheRgbDimmer_StopChannelFade(channel);
+	}
+	mapping->rampUp = !mapping->rampUp;
+}
+
+/*!	@brief Advance gesture recognition on a button edge
+ *
+ *	@param[in] *mapping		Pin-command-mapping entry
+ *	@param[in] pressed		New button state
+ *	@param[in] timestamp	Time of the edge
+ *	@return uint8_t			Gesture to run, or ETHERGB_IO_GESTURE_COUNT
+ *	@date 19.10.26			First implementation					*/
+static uint8_t etheRgbIO_GestureEdge(etheRgbPinIoCommandMapping_t* mapping, bool pressed, uint16_t timestamp)
+{
+	uint8_t gesture = ETHERGB_IO_GESTURE_COUNT;
+
+	switch (mapping->gestureState)
+	{
+		case GESTURE_STATE_IDLE:
+			if (pressed)
+				mapping->gestureState = GESTURE_STATE_PRESSED;
+			break;
+		case GESTURE_STATE_PRESSED:
+			if (pressed)
+				break;
+			if (mapping->commands[GESTURE_DOUBLE_CLICK].command == ETHERGB_INVALID_COMMAND)
+			{
+				// Nothing to wait for
+				gesture = GESTURE_CLICK;
+				mapping->gestureState = GESTURE_STATE_IDLE;
+			}
+			else
+			{
+				mapping->gestureState = GESTURE_STATE_RELEASED;
+			}
+			break;
+		case GESTURE_STATE_RELEASED:
+			if (pressed)
+			{
+				gesture = GESTURE_DOUBLE_CLICK;
+				mapping->gestureState = GESTURE_STATE_SECOND;
+			}
+			break;
+		case GESTURE_STATE_HELD:
+			if (!pressed)
+			{
+				etheRgbIO_StopRamp(mapping);
+				mapping->gestureState = GESTURE_STATE_IDLE;
+			}
+			break;
+		default:
+			if (!pressed)
+				mapping->gestureState = GESTURE_STATE_IDLE;
+			break;
+	}
+
+	mapping->gestureTime = timestamp;
+	return gesture;
+}
+
+/*!	@brief Advance gesture recognition on elapsed time
+ *
+ *	@param[in] *mapping		Pin-command-mapping entry
+ *	@param[in] now			Current time
+ *	@return uint8_t			Gesture to run, or ETHERGB_IO_GESTURE_COUNT
+ *	@date 19.10.26			First implementation					*/
+static uint8_t etheRgbIO_GestureTimeout(etheRgbPinIoCommandMapping_t* mapping, uint16_t now)
+{
+	uint16_t elapsed = now - mapping->gestureTime;
+
+	if ((mapping->gestureState == GESTURE_STATE_PRESSED) && (elapsed >= ETHERGB_IO_LONG_PRESS_MS))
+	{
+		mapping->gestureState = GESTURE_STATE_HELD;
+		etheRgbIO_StartRamp(mapping);
+		return GESTURE_LONG_PRESS;
+	}
+	if ((mapping->gestureState == GESTURE_STATE_RELEASED) && (elapsed >= ETHERGB_IO_DOUBLE_CLICK_MS))
+	{
+		mapping->gestureState = GESTURE_STATE_IDLE;
+		return GESTURE_CLICK;
+	}
+	return ETHERGB_IO_GESTURE_COUNT;
+}
+
+/*!	@brief Check a mapping against a pin change event
+ *
+ *	@param[in] *mapping		Pin-command-mapping entry
+ *	@param[in] *event		Pin change event
+ *	@return uint8_t			Gesture slot to run, or ETHERGB_IO_GESTURE_COUNT
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Gesture triggers						*/
+static uint8_t etheRgbIO_EdgeTriggered(etheRgbPinIoCommandMapping_t* mapping, inputEvent_t* event)
+{
+	if (inputGetPort(mapping->pin) != event->port)
+		return ETHERGB_IO_GESTURE_COUNT;
+
+	uint8_t mask = 1 << mapping->pin->Number;
+	if ((event->changed & mask) == 0)
+		return ETHERGB_IO_GESTURE_COUNT;
+
+	bool currentState = (event->state & mask) != 0;
+	switch (mapping->trigger)
+	{
+		case TRIGGER_RISING:
+			return (currentState == HIGH) ? GESTURE_CLICK : ETHERGB_IO_GESTURE_COUNT;
+		case TRIGGER_FALLING:
+			return (currentState == LOW) ? GESTURE_CLICK : ETHERGB_IO_GESTURE_COUNT;
+		case TRIGGER_CHANGE:
+			return GESTURE_CLICK;
+		case TRIGGER_GESTURE_HIGH:
+			return etheRgbIO_GestureEdge(mapping, currentState == HIGH, event->timestamp);
+		case TRIGGER_GESTURE_LOW:
+			return etheRgbIO_GestureEdge(mapping, currentState == LOW, event->timestamp);
+		default:
+			return ETHERGB_IO_GESTURE_COUNT;
+	}
+}
+
+/*!	@brief Copy a mapping's command to the shared command buffer
+ *
+ *	@param[in] *mapping		Pin-command-mapping entry
+ *	@param[in] gesture		Gesture slot
+ *	@return bool			true, if a command was loaded
+ *	@date 19.10.26			Moved from etheRgbIO_Poll
+ *	@date 19.10.26			Gesture command slots					*/
+static bool etheRgbIO_LoadCommand(etheRgbPinIoCommandMapping_t* mapping, uint8_t gesture)
+{
+	if (gesture >= ETHERGB_IO_GESTURE_COUNT)
+		return false;
+
+	etheRgbIoCommand_t* slot = &mapping->commands[gesture];
+	if (slot->command == ETHERGB_INVALID_COMMAND)
+		return false;
+
+	SharedCommandBuffer->commandType = slot->command;
+	for (int i=0; i < ETHERGB_IO_MAX_DATA_LENGTH; ++i)
+	{
+		SharedCommandBuffer->data[i] = slot->data[i];
+	}
+	SharedCommandBuffer->dataLength = slot->dataLength;
+	SharedCommandBuffer->source = SOURCE_IO;
+	return true;
+}
+
 /*!	@brief I/O module polling function 
  *
  *	Handles input pin triggering and calls the command associated
- *	with the pin.
+ *	with the pin. Encoder detents and analog inputs are applied
+ *	first, then infrared keys and queued edge events are evaluated,
+ *	then gesture timeouts, then level triggers. Since only one
+ *	command fits the shared buffer, the rest is continued in the
+ *	next call.
  *
- *	@date 11.07.17			Restructuring							*/
+ *	@date 11.07.17			Restructuring
+ *	@date 19.10.26			Edge triggers from pin change events
+ *	@date 19.10.26			Debounced level triggers
+ *	@date 19.10.26			Gestures, level trigger rate limit
+ *	@date 19.10.26			Rotary encoders
+ *	@date 19.10.26			Analog inputs
+ *	@date 19.10.26			Infrared remote keys					*/
 etheRgbSource_t etheRgbIO_Poll(void)
 {
 	if (SharedCommandBuffer == NULL)
@@ -118,37 +984,70 @@ etheRgbSource_t etheRgbIO_Poll(void)
 		LOG_CRASH(SRC_ETHERGB, "NULL pointer access at SharedCommandBuffer.");
 	}
 
-	// Default return value is "no pin triggered"
-	etheRgbSource_t returnValue = SOURCE_NONE;
+	etheRgbIO_PollEncoders();
+	etheRgbIO_PollAnalog();
 
-	// Update pin states
-	bool currentState = ioReadPin(PinCommandMap[PinCommandMapIndex].pin);
-	PinCommandMap[PinCommandMapIndex].stateHistory <<= 1;
-	PinCommandMap[PinCommandMapIndex].stateHistory |= currentState << ETHERGB_IO_PIN_CURRENT_STATE;
-	bool lastState = PinCommandMap[PinCommandMapIndex].stateHistory & (1 << ETHERGB_IO_PIN_LAST_STATE);
+	if (etheRgbIO_PollIr())
+		return SOURCE_IO;
 
-	// Check pin trigger
-	if (((PinCommandMap[PinCommandMapIndex].trigger == TRIGGER_RISING) && (currentState == HIGH) && (lastState == LOW)) ||
-		((PinCommandMap[PinCommandMapIndex].trigger == TRIGGER_FALLING) && (currentState == LOW) && (lastState == HIGH)) ||
-		((PinCommandMap[PinCommandMapIndex].trigger == TRIGGER_CHANGE) && (currentState != lastState)) ||
-		((PinCommandMap[PinCommandMapIndex].trigger == TRIGGER_HIGH) && (currentState == HIGH)) ||
-		((PinCommandMap[PinCommandMapIndex].trigger == TRIGGER_LOW) && (currentState == LOW)))
+	// Edge triggers and gesture transitions
+	while (true)
 	{
-		// Pin triggered, copy data to shared command buffer
-		SharedCommandBuffer->commandType = PinCommandMap[PinCommandMapIndex].command;
-		for (int i=0; i < ETHERGB_MAX_DATA_LENGTH; ++i)
+		if (PendingEventIndex >= ETHERGB_MAX_COMMAND_PINS)
 		{
-			SharedCommandBuffer->data[i] = PinCommandMap[PinCommandMapIndex].data[i];
+			if (!inputGetEvent(&PendingEvent))
+				break;
+			PendingEventIndex = 0;
 		}
-		SharedCommandBuffer->dataLength = PinCommandMap[PinCommandMapIndex].dataLength;
-		SharedCommandBuffer->source = SOURCE_IO;
 
-		// IO "Packet" complete
-		returnValue = SOURCE_IO;
+		while (PendingEventIndex < ETHERGB_MAX_COMMAND_PINS)
+		{
+			etheRgbPinIoCommandMapping_t* mapping = &PinCommandMap[PendingEventIndex++];
+			if (etheRgbIO_LoadCommand(mapping, etheRgbIO_EdgeTriggered(mapping, &PendingEvent)))
+			{
+				// IO "Packet" complete
+				return SOURCE_IO;
+			}
+		}
+	}
+
+	uint16_t now = clockMillis16();
+
+	// Gesture timeouts
+	for (uint8_t i = 0; i < ETHERGB_MAX_COMMAND_PINS; ++i)
+	{
+		if (PinCommandMap[i].gestureState == GESTURE_STATE_IDLE)
+			continue;
+		if ((PinCommandMap[i].trigger != TRIGGER_GESTURE_HIGH) && (PinCommandMap[i].trigger != TRIGGER_GESTURE_LOW))
+			continue;
+
+		if (etheRgbIO_LoadCommand(&PinCommandMap[i], etheRgbIO_GestureTimeout(&PinCommandMap[i], now)))
+			return SOURCE_IO;
 	}
 
-	// Check next pin in next polling cycle
+	// Level triggers, one pin per polling cycle
+	etheRgbPinIoCommandMapping_t* mapping = &PinCommandMap[PinCommandMapIndex];
 	PinCommandMapIndex = (PinCommandMapIndex + 1) % ETHERGB_MAX_COMMAND_PINS;
 
-	return returnValue;
-}
\ No newline at end of file
+	if (mapping->pin == NULL || (mapping->trigger != TRIGGER_HIGH && mapping->trigger != TRIGGER_LOW))
+		return SOURCE_NONE;
+
+	bool currentState = inputReadPin(mapping->pin);
+	if (currentState != (mapping->trigger == TRIGGER_HIGH))
+	{
+		mapping->gestureState = GESTURE_STATE_IDLE;
+		return SOURCE_NONE;
+	}
+
+	// Fire on entering the level, then repeat at a limited rate
+	if ((mapping->gestureState == GESTURE_STATE_IDLE) ||
+		((uint16_t)(now - mapping->gestureTime) >= ETHERGB_IO_LEVEL_REPEAT_MS))
+	{
+		mapping->gestureState = GESTURE_STATE_PRESSED;
+		mapping->gestureTime = now;
+		if (etheRgbIO_LoadCommand(mapping, GESTURE_CLICK))
+			return SOURCE_IO;
+	}
+
+	return SOURCE_NONE;
+}
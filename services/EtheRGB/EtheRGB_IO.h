@@ -4,47 +4,185 @@
  *
  *	@author	inselc
  *	@date 10.07.17		First implementation
- *	@date 11.07.17		Restructuring						*/
+ *	@date 11.07.17		Restructuring
+ *	@date 19.10.26		Edge triggers from pin change events
+ *	@date 19.10.26		Gesture triggers
+ *	@date 19.10.26		Configuration records, EEPROM persistence
+ *	@date 19.10.26		Rotary encoders
+ *	@date 19.10.26		Analog inputs
+ *	@date 19.10.26		Infrared remote keys
+ *	@date 19.10.26		Pin availability for dimmer outputs			*/
 
 #ifndef ETHERGB_IO_H_
 #define ETHERGB_IO_H_
 
 /*!	@file */
 
+#include <stdint.h>
+#include <stdbool.h>
 #include "../../modules/io/io.h"
+#include "../../core/Input/Input.h"
+#include "../../core/IR/IR.h"
 
 /*extern*/ enum etheRgbSource_t;
 
+#define ETHERGB_MAX_COMMAND_PINS		4
+#define ETHERGB_MAX_ENCODERS			INPUT_MAX_ENCODERS
+#define ETHERGB_MAX_ANALOG_INPUTS		2
+#define ETHERGB_IO_ANALOG_NONE			0xFF	/* etheRgbIoAnalogConfig_t::input of unused entries */
+#define ETHERGB_MAX_IR_KEYS				16
+#define ETHERGB_IO_MAX_DATA_LENGTH		8		/* Data bytes stored per mapped command */
+#define ETHERGB_IO_FLAG_PULLUP			0x01	/* Digital inputs: enable pull-up */
+#define ETHERGB_IO_FLAG_INVERT			0x02	/* Analog inputs: highest input gives lowest level */
+#define ETHERGB_IO_FLAG_REPEAT			0x04	/* IR keys: repeat the command while the key is held */
+
+#define ETHERGB_IO_LONG_PRESS_MS		600		/* Hold time for a long press */
+#define ETHERGB_IO_DOUBLE_CLICK_MS		300		/* Max. release time between double click presses */
+#define ETHERGB_IO_LEVEL_REPEAT_MS		250		/* Repeat interval of level triggers */
+
 /*!	@enum etheRgbIoTrigger_t
  *	@brief Pin trigger mode
  *
- *	@date 11.07.17			Rework; added TRIGGER_CHANGE			*/
+ *	@date 11.07.17			Rework; added TRIGGER_CHANGE
+ *	@date 19.10.26			Added gesture triggers					*/
 typedef enum {
-	TRIGGER_NONE,		//!< Never triggers
-	TRIGGER_RISING,		//!< Trigger on rising edge
-	TRIGGER_FALLING,	//!< Trigger on falling edge
-	TRIGGER_CHANGE,		//!< Trigger on rising and falling edges
-	TRIGGER_HIGH,		//!< Trigger when signal is HIGH
-	TRIGGER_LOW			//!< Trigger when signal is LOW
+	TRIGGER_NONE,			//!< Never triggers
+	TRIGGER_RISING,			//!< Trigger on rising edge
+	TRIGGER_FALLING,		//!< Trigger on falling edge
+	TRIGGER_CHANGE,			//!< Trigger on rising and falling edges
+	TRIGGER_HIGH,			//!< Trigger repeatedly while signal is HIGH
+	TRIGGER_LOW,			//!< Trigger repeatedly while signal is LOW
+	TRIGGER_GESTURE_HIGH,	//!< Button gestures, pressed when HIGH
+	TRIGGER_GESTURE_LOW		//!< Button gestures, pressed when LOW
 } etheRgbIoTrigger_t;
 
+/*!	@enum etheRgbIoGesture_t
+ *	@brief Gesture command slots
+ *
+ *	Edge and level triggers only use the first slot.
+ *
+ *	@date 19.10.26			First implementation					*/
+typedef enum {
+	GESTURE_CLICK = 0,		//!< Short press
+	GESTURE_DOUBLE_CLICK,	//!< Two short presses
+	GESTURE_LONG_PRESS,		//!< Press held for ETHERGB_IO_LONG_PRESS_MS
+	ETHERGB_IO_GESTURE_COUNT
+} etheRgbIoGesture_t;
+
+/*!	@struct etheRgbIoCommand_t
+ *	@brief Command stored in an I/O mapping
+ *
+ *	@date 19.10.26			First implementation					*/
+typedef struct __attribute__((packed)) {
+	uint8_t command;						//!< Command type
+	uint8_t data[ETHERGB_IO_MAX_DATA_LENGTH];	//!< Command data
+	uint8_t dataLength;						//!< Command data length
+} etheRgbIoCommand_t;
+
 /*!	@struct etheRgbPinCommandMapping_t
  *	@brief Mapping of a command to a digital input pin
  *
- *	@date 11.07.17			Rework									*/
+ *	Gesture mappings may additionally ramp dimmer channels while the
+ *	button is held past a long press: the channels fade up or down,
+ *	alternating with each hold, and stop where they are on release.
+ *
+ *	@date 11.07.17			Rework
+ *	@date 19.10.26			Removed state history
+ *	@date 19.10.26			Gesture command slots, ramp				*/
 typedef struct __attribute__((packed)) {
 	pin_t* pin;								//!< Input pin
 	etheRgbIoTrigger_t trigger;				//!< Trigger type
-	uint8_t command;						//!< Command type
-	uint8_t data[ETHERGB_MAX_DATA_LENGTH];	//!< Command data
-	uint8_t dataLength;						//!< Command data length
-	uint8_t stateHistory;					//!< Previous pin states
+	etheRgbIoCommand_t commands[ETHERGB_IO_GESTURE_COUNT];	//!< Commands by gesture
+	uint8_t rampChannels;					//!< Channel bit mask to ramp on hold
+	uint8_t rampSpeed;						//!< Fading speed of the ramp
+	uint8_t gestureState;					//!< Gesture recognition state
+	uint16_t gestureTime;					//!< Time of the last gesture transition
+	bool rampUp;							//!< Direction of the next ramp
 } etheRgbPinIoCommandMapping_t;
 
+/*!	@struct etheRgbIoConfig_t
+ *	@brief Stored form of a pin-command-mapping
+ *
+ *	Used for the EEPROM table and the configuration commands. The
+ *	pin is given by port (inputPort_t) and number instead of a
+ *	pointer; a port of INPUT_PORT_NONE (or erased EEPROM) marks an
+ *	unused entry.
+ *
+ *	@date 19.10.26			First implementation					*/
+typedef struct __attribute__((packed)) {
+	uint8_t port;							//!< Input port (inputPort_t)
+	uint8_t number;							//!< Pin number at the port
+	uint8_t flags;							//!< ETHERGB_IO_FLAG_* bits
+	uint8_t trigger;						//!< Trigger type
+	etheRgbIoCommand_t commands[ETHERGB_IO_GESTURE_COUNT];	//!< Commands by gesture
+	uint8_t rampChannels;					//!< Channel bit mask to ramp on hold
+	uint8_t rampSpeed;						//!< Fading speed of the ramp
+} etheRgbIoConfig_t;
+
+/*!	@struct etheRgbIoEncoderConfig_t
+ *	@brief Rotary encoder mapping
+ *
+ *	Each detent changes the brightness of all channels in the mask
+ *	by stepSize. Both pins have to be on the same port; a port of
+ *	INPUT_PORT_NONE marks an unused entry.
+ *
+ *	@date 19.10.26			First implementation					*/
+typedef struct __attribute__((packed)) {
+	uint8_t port;							//!< Input port (inputPort_t)
+	uint8_t numberA;						//!< Pin number of encoder pin A
+	uint8_t numberB;						//!< Pin number of encoder pin B
+	uint8_t flags;							//!< ETHERGB_IO_FLAG_* bits
+	uint8_t channels;						//!< Channel bit mask
+	uint8_t stepSize;						//!< Brightness change per detent
+} etheRgbIoEncoderConfig_t;
+
+/*!	@struct etheRgbIoAnalogConfig_t
+ *	@brief Analog input mapping
+ *
+ *	Sets the level of all channels in the mask from an ADC channel,
+ *	e.g. a potentiometer or a light sensor.
+ *
+ *	@date 19.10.26			First implementation					*/
+typedef struct __attribute__((packed)) {
+	uint8_t input;							//!< ADC channel, or ETHERGB_IO_ANALOG_NONE
+	uint8_t flags;							//!< ETHERGB_IO_FLAG_* bits
+	uint8_t channels;						//!< Channel bit mask
+} etheRgbIoAnalogConfig_t;
+
+/*!	@struct etheRgbIoIrKey_t
+ *	@brief Infrared remote key mapping
+ *
+ *	Runs the command when a key code with matching protocol, address
+ *	and key is received. A protocol of IR_PROTOCOL_NONE (or erased
+ *	EEPROM) marks an unused entry.
+ *
+ *	@date 19.10.26			First implementation					*/
+typedef struct __attribute__((packed)) {
+	uint8_t protocol;						//!< Remote protocol (irProtocol_t)
+	uint16_t address;						//!< Device address
+	uint8_t code;							//!< Key code
+	uint8_t flags;							//!< ETHERGB_IO_FLAG_* bits
+	etheRgbIoCommand_t command;				//!< Command to run
+} etheRgbIoIrKey_t;
+
 void etheRgbIO_Init(etheRgbCommand_t* commandBuffer);
 void etheRgbIO_Reset(void);
 void etheRgbIO_SetupMapping(uint8_t index, pin_t* pin, etheRgbIoTrigger_t trigger, etheRgbCommand_t* command);
 void etheRgbIO_GetMapping(uint8_t index, pin_t** pin, etheRgbIoTrigger_t* trigger, etheRgbCommand_t* command);
+void etheRgbIO_SetupGesture(uint8_t index, etheRgbIoGesture_t gesture, etheRgbCommand_t* command);
+void etheRgbIO_SetupRamp(uint8_t index, uint8_t channels, uint8_t speed);
+bool etheRgbIO_GetConfig(uint8_t index, etheRgbIoConfig_t* config);
+bool etheRgbIO_SetConfig(uint8_t index, const etheRgbIoConfig_t* config);
+bool etheRgbIO_GetEncoderConfig(uint8_t index, etheRgbIoEncoderConfig_t* config);
+bool etheRgbIO_SetEncoderConfig(uint8_t index, const etheRgbIoEncoderConfig_t* config);
+bool etheRgbIO_GetAnalogConfig(uint8_t index, etheRgbIoAnalogConfig_t* config);
+bool etheRgbIO_SetAnalogConfig(uint8_t index, const etheRgbIoAnalogConfig_t* config);
+bool etheRgbIO_GetIrKey(uint8_t index, etheRgbIoIrKey_t* key);
+bool etheRgbIO_SetIrKey(uint8_t index, const etheRgbIoIrKey_t* key);
+bool etheRgbIO_GetLastIrCode(irCode_t* code);
+bool etheRgbIO_IsPinFree(uint8_t port, uint8_t number);
+void etheRgbIO_LoadConfig(void);
+void etheRgbIO_SaveConfig(void);
 etheRgbSource_t etheRgbIO_Poll(void);
 
 #endif /* ETHERGB_IO_H_ */
\ No newline at end of file
@@ -0,0 +1,113 @@
+/*!	@brief EtheRGB Scene module
+ *
+ *	Scenes are held in EEPROM. The most recently used ones are cached
+ *	in RAM, so a recall does not wait for the EEPROM, and scenes
+ *	stored over and over (e.g. by a preset button) are only written
+ *	where they changed.
+ *
+ *	A recall hands the scene to the dimmer's crossfade, so all
+ *	channels reach the scene's values at the same time.
+ *
+ *	@author	inselc
+ *	@date 19.10.26			First implementation					*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <avr/eeprom.h>
+#include "../../core/Log/Log.h"
+#include "EtheRGB_Command.h"
+#include "EtheRGB_Dimmer.h"
+#include "EtheRGB_Scene.h"
+#include "EtheRGB_Config.h"
+
+/*!	@brief Cached scene												*/
+typedef struct {
+	uint8_t scene;								//!< Scene number, or ETHERGB_SCENE_NONE
+	uint8_t values[ETHERGB_MAX_OUTPUT_PINS];	//!< Channel values
+} etheRgbSceneCache_t;
+
+static etheRgbSceneCache_t SceneCache[ETHERGB_SCENE_CACHE_SIZE];
+static uint8_t SceneCacheNext = 0;				//!< Cache entry to be replaced next
+
+/*!	@brief Get a scene's cache entry, loading it on a miss
+ *
+ *	@param[in] scene		Scene number, checked by the caller
+ *	@return etheRgbSceneCache_t*	Cache entry
+ *	@date 19.10.26			First implementation					*/
+static etheRgbSceneCache_t* etheRgbScene_Load(uint8_t scene)
+{
+	for (uint8_t i = 0; i < ETHERGB_SCENE_CACHE_SIZE; ++i)
+	{
+		if (SceneCache[i].scene == scene)
+			return &SceneCache[i];
+	}
+
+	etheRgbSceneCache_t* entry = &SceneCache[SceneCacheNext];
+	SceneCacheNext = (SceneCacheNext + 1) % ETHERGB_SCENE_CACHE_SIZE;
+
+	eeprom_read_block(entry->values, EtheRgbScenes[scene], sizeof(entry->values));
+	entry->scene = scene;
+	return entry;
+}
+
+/*!	@brief Initialize the scene module
+ *
+ *	@date 19.10.26			First implementation					*/
+void etheRgbScene_Init(void)
+{
+	for (uint8_t i = 0; i < ETHERGB_SCENE_CACHE_SIZE; ++i)
+	{
+		SceneCache[i].scene = ETHERGB_SCENE_NONE;
+	}
+	SceneCacheNext = 0;
+}
+
+/*!	@brief Store the current channel values as a scene
+ *
+ *	@param[in] scene		Scene number
+ *	@return bool			false, if the scene number is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbScene_Store(uint8_t scene)
+{
+	if (scene >= ETHERGB_MAX_SCENES)
+		return false;
+
+	etheRgbSceneCache_t* entry = etheRgbScene_Load(scene);
+	for (uint8_t i = 0; i < ETHERGB_MAX_OUTPUT_PINS; ++i)
+	{
+		entry->values[i] = etheRgbDimmer_GetChannelValue(i);
+	}
+	eeprom_update_block(entry->values, EtheRgbScenes[scene], sizeof(entry->values));
+	return true;
+}
+
+/*!	@brief Recall a scene
+ *
+ *	@param[in] scene		Scene number
+ *	@param[in] duration		Crossfade duration in ms, 0 to set at once
+ *	@return bool			false, if the scene number is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbScene_Recall(uint8_t scene, uint16_t duration)
+{
+	if (scene >= ETHERGB_MAX_SCENES)
+		return false;
+
+	etheRgbDimmer_Crossfade(etheRgbScene_Load(scene)->values, duration);
+	return true;
+}
+
+/*!	@brief Read a scene's channel values
+ *
+ *	@param[in] scene		Scene number
+ *	@param[out] *values		Channel values, ETHERGB_MAX_OUTPUT_PINS bytes
+ *	@return bool			false, if the scene number is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbScene_GetValues(uint8_t scene, uint8_t* values)
+{
+	if (scene >= ETHERGB_MAX_SCENES || values == NULL)
+		return false;
+
+	memcpy(values, etheRgbScene_Load(scene)->values, ETHERGB_MAX_OUTPUT_PINS);
+	return true;
+}
@@ -0,0 +1,44 @@
+/*!	@brief EtheRGB Scene module
+ *
+ *	Stores snapshots of all channel values, and recalls them at once
+ *	or as a crossfade.
+ *
+ *	A scene takes one EEPROM byte per channel, so the number of scenes
+ *	shrinks as channels are added: 10 scenes for 16 channels, 2 for
+ *	64 channels. Builds with too many channels for
+ *	ETHERGB_MIN_SCENES scenes fail.
+ *
+ *	@author	inselc
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Less EEPROM, room for cues
+ *	@date 19.10.26			Less EEPROM, room for groups
+ *	@date 19.10.26			Lower limit for the number of scenes	*/
+
+#ifndef ETHERGB_SCENE_H_
+#define ETHERGB_SCENE_H_
+
+/*!	@file */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "EtheRGB_Dimmer.h"
+
+#define ETHERGB_SCENE_EEPROM_SIZE	160		/* EEPROM bytes for scenes */
+#if (ETHERGB_SCENE_EEPROM_SIZE / ETHERGB_MAX_OUTPUT_PINS) < 16
+#define ETHERGB_MAX_SCENES			(ETHERGB_SCENE_EEPROM_SIZE / ETHERGB_MAX_OUTPUT_PINS)
+#else
+#define ETHERGB_MAX_SCENES			16
+#endif
+#define ETHERGB_MIN_SCENES			2		/* Fewest scenes a build may have */
+#if ETHERGB_MAX_SCENES < ETHERGB_MIN_SCENES
+#error "Too many channels for ETHERGB_MIN_SCENES scenes in ETHERGB_SCENE_EEPROM_SIZE bytes"
+#endif
+#define ETHERGB_SCENE_CACHE_SIZE	4		/* Scenes held in RAM */
+#define ETHERGB_SCENE_NONE			0xFF	/* Cache tag of an unused cache entry */
+
+void etheRgbScene_Init(void);
+bool etheRgbScene_Store(uint8_t scene);
+bool etheRgbScene_Recall(uint8_t scene, uint16_t duration);
+bool etheRgbScene_GetValues(uint8_t scene, uint8_t* values);
+
+#endif /* ETHERGB_SCENE_H_ */
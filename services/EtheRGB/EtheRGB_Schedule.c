@@ -0,0 +1,163 @@
+/*!	@brief EtheRGB Schedule module
+ *
+ *	The show clock is the millisecond clock plus an offset, which a
+ *	controller sets to align its devices. Scheduled commands are kept
+ *	sorted by their time, so polling only checks the first one. A due
+ *	command is loaded into the shared command buffer like an IO
+ *	command; its response is dropped. Times are compared as signed
+ *	differences, so the clock may wrap, as long as commands are
+ *	scheduled less than 24 days ahead. Commands scheduled in the past
+ *	run at once.
+ *
+ *	@author	inselc
+ *	@date 19.10.26			First implementation					*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "../../core/Clock/Clock.h"
+#include "../../core/Log/Log.h"
+#include "EtheRGB_Command.h"
+#include "EtheRGB_Schedule.h"
+
+/*!	@struct etheRgbScheduledCommand_t
+ *	@brief Queued command
+ *
+ *	@date 19.10.26			First implementation					*/
+typedef struct __attribute__((packed)) {
+	uint32_t time;								//!< Show clock time to run at, in ms
+	uint8_t command;							//!< Command number
+	uint8_t dataLength;							//!< Number of data bytes
+	uint8_t data[ETHERGB_SCHEDULE_DATA_LENGTH];	//!< Data bytes
+} etheRgbScheduledCommand_t;
+
+static etheRgbScheduledCommand_t ScheduleQueue[ETHERGB_SCHEDULE_SLOTS];	//!< Commands, earliest first
+static uint8_t ScheduleCount = 0;				//!< Number of queued commands
+static uint32_t ScheduleClockOffset = 0;		//!< Show clock minus millisecond clock
+static etheRgbCommand_t* SharedCommandBuffer = NULL;
+
+/*!	@brief Initialize the schedule module
+ *
+ *	@param[in] *commandBuffer	Shared command buffer
+ *	@date 19.10.26			First implementation					*/
+void etheRgbSchedule_Init(etheRgbCommand_t* commandBuffer)
+{
+	SharedCommandBuffer = commandBuffer;
+	ScheduleCount = 0;
+	ScheduleClockOffset = 0;
+}
+
+/*!	@brief Schedule polling function
+ *
+ *	Loads the first command into the shared command buffer, once it
+ *	is due. Commands due at the same time are loaded one per call.
+ *
+ *	@return etheRgbSource_t	SOURCE_SCHEDULE, if a command was loaded
+ *	@date 19.10.26			First implementation					*/
+etheRgbSource_t etheRgbSchedule_Poll(void)
+{
+	if (SharedCommandBuffer == NULL)
+	{
+		LOG_CRASH(SRC_ETHERGB, "NULL pointer access at SharedCommandBuffer.");
+	}
+
+	if (ScheduleCount == 0)
+		return SOURCE_NONE;
+
+	etheRgbScheduledCommand_t* entry = &ScheduleQueue[0];
+	if ((int32_t)(etheRgbSchedule_GetClock() - entry->time) < 0)
+		return SOURCE_NONE;
+
+	SharedCommandBuffer->commandType = entry->command;
+	for (uint8_t i = 0; i < ETHERGB_SCHEDULE_DATA_LENGTH; ++i)
+	{
+		SharedCommandBuffer->data[i] = entry->data[i];
+	}
+	SharedCommandBuffer->dataLength = entry->dataLength;
+	SharedCommandBuffer->source = SOURCE_SCHEDULE;
+
+	--ScheduleCount;
+	memmove(&ScheduleQueue[0], &ScheduleQueue[1], ScheduleCount * sizeof(etheRgbScheduledCommand_t));
+	return SOURCE_SCHEDULE;
+}
+
+/*!	@brief Schedule a command
+ *
+ *	Commands with the same time run in the order they were added.
+ *
+ *	@param[in] time			Show clock time to run at, in ms
+ *	@param[in] command		Command number
+ *	@param[in] *data		Data bytes
+ *	@param[in] dataLength	Number of data bytes
+ *	@return bool			false, if the queue is full, the command is
+ *							unknown or needs more data than given
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbSchedule_Add(uint32_t time, uint8_t command, const uint8_t* data, uint8_t dataLength)
+{
+	if ((ScheduleCount >= ETHERGB_SCHEDULE_SLOTS) ||
+		(dataLength > ETHERGB_SCHEDULE_DATA_LENGTH) || (data == NULL) ||
+		!etheRgbCommand_HasCommand(command) ||
+		(etheRgbCommand_GetRequiredDataLength(command) > dataLength))
+	{
+		return false;
+	}
+
+	// Insert behind all commands due no later
+	uint32_t now = etheRgbSchedule_GetClock();
+	int32_t due = (int32_t)(time - now);
+	uint8_t index = ScheduleCount;
+	while ((index > 0) && ((int32_t)(ScheduleQueue[index - 1].time - now) > due))
+	{
+		--index;
+	}
+	memmove(&ScheduleQueue[index + 1], &ScheduleQueue[index], (ScheduleCount - index) * sizeof(etheRgbScheduledCommand_t));
+	++ScheduleCount;
+
+	etheRgbScheduledCommand_t* entry = &ScheduleQueue[index];
+	entry->time = time;
+	entry->command = command;
+	entry->dataLength = dataLength;
+	for (uint8_t i = 0; i < ETHERGB_SCHEDULE_DATA_LENGTH; ++i)
+	{
+		entry->data[i] = (i < dataLength) ? data[i] : 0x00;
+	}
+	return true;
+}
+
+/*!	@brief Drop all scheduled commands
+ *
+ *	@date 19.10.26			First implementation					*/
+void etheRgbSchedule_Clear(void)
+{
+	ScheduleCount = 0;
+}
+
+/*!	@brief Get the number of scheduled commands
+ *
+ *	@return uint8_t			Number of commands waiting
+ *	@date 19.10.26			First implementation					*/
+uint8_t etheRgbSchedule_GetCount(void)
+{
+	return ScheduleCount;
+}
+
+/*!	@brief Get the show clock
+ *
+ *	@return uint32_t		Show clock, in ms
+ *	@date 19.10.26			First implementation					*/
+uint32_t etheRgbSchedule_GetClock(void)
+{
+	return clockMillis() + ScheduleClockOffset;
+}
+
+/*!	@brief Set the show clock
+ *
+ *	Scheduled commands keep their show clock times, so they move with
+ *	the clock.
+ *
+ *	@param[in] time			Show clock, in ms
+ *	@date 19.10.26			First implementation					*/
+void etheRgbSchedule_SetClock(uint32_t time)
+{
+	ScheduleClockOffset = time - clockMillis();
+}
@@ -0,0 +1,30 @@
+/*!	@brief EtheRGB Schedule module
+ *
+ *	Holds commands until a given time on the show clock, so a
+ *	controller can send them ahead of time and several devices act
+ *	at the same moment, regardless of network delays.
+ *
+ *	@author	inselc
+ *	@date 19.10.26			First implementation					*/
+
+#ifndef ETHERGB_SCHEDULE_H_
+#define ETHERGB_SCHEDULE_H_
+
+/*!	@file */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "EtheRGB_Command.h"
+
+#define ETHERGB_SCHEDULE_SLOTS			8		/* Commands waiting at the same time */
+#define ETHERGB_SCHEDULE_DATA_LENGTH	10		/* Data bytes per scheduled command */
+
+void etheRgbSchedule_Init(etheRgbCommand_t* commandBuffer);
+etheRgbSource_t etheRgbSchedule_Poll(void);
+bool etheRgbSchedule_Add(uint32_t time, uint8_t command, const uint8_t* data, uint8_t dataLength);
+void etheRgbSchedule_Clear(void);
+uint8_t etheRgbSchedule_GetCount(void);
+uint32_t etheRgbSchedule_GetClock(void);
+void etheRgbSchedule_SetClock(uint32_t time);
+
+#endif /* ETHERGB_SCHEDULE_H_ */
@@ -3,13 +3,17 @@
  *	@author	inselc
  *	@date	21.05.17		First implementation
  *	@date	08.07.17		Reworked Comms module
- *	@date	11.07.17		Restructuring							*/
+ *	@date	11.07.17		Restructuring
+ *	@date	19.10.26		Drain input per poll, running checksum
+ *	@date	19.10.26		Deferred logging on packet paths
+ *	@date	19.10.26		Responses sent on the protocol channel	*/
 
 /*	@todo	Response packets */
 
 #include <stdio.h>
 #include <stdint.h>
 #include "../../core/Serial/Serial.h"
+#include "../../core/Serial/SerialFrame.h"
 #include "../../core/Log/Log.h"
 #include "EtheRGB_Command.h"
 #include "EtheRGB_Serial.h"
@@ -28,11 +32,15 @@ typedef enum {
 	STATE_GOT_CHECKSUM
 } etheRgbSerialState_t;
 
+#define ETHERGB_SERIAL_POLL_BUDGET 32	/* Maximum bytes processed per poll */
+
 static uint8_t LocalCommandDataBuffer[ETHERGB_MAX_DATA_LENGTH] = { 0x00 };
 static etheRgbCommand_t* SharedCommandBuffer = NULL;
 static etheRgbCommand_t LocalCommandBuffer = {ETHERGB_INVALID_COMMAND, LocalCommandDataBuffer, 0, SOURCE_SERIAL};
 static etheRgbSerialState_t SerialStateMachine = STATE_IDLE;
 static uint16_t TimeoutCounter = 0;
+static uint8_t RequiredDataLength = 0;
+static uint8_t RunningChecksum = 0;
 
 /*!	@brief Initialize the Serial module
  *
@@ -51,23 +59,144 @@ void etheRgbSerial_Init(etheRgbCommand_t* commandBuffer)
  *	Resets the internal state machine into idle state, the local
  *	command buffer to default values and the timeout counter to 0
  *
- *	@date 11.07.17			First implementation					*/ 
+ *	@date 11.07.17			First implementation
+ *	@date 19.10.26			Reset running checksum					*/ 
 void etheRgbSerial_Reset(void)
 {
 	SerialStateMachine = STATE_IDLE;
 	TimeoutCounter = 0;
+	RequiredDataLength = 0;
+	RunningChecksum = 0;
 	LocalCommandBuffer.commandType = ETHERGB_INVALID_COMMAND;
 	LocalCommandBuffer.dataLength = 0;
 }
 
+/*!	@brief Read the data section of a packet in one go
+ *
+ *	Copies as much of the remaining data section as is available
+ *	(limited by budget) and adds it to the running checksum.
+ *
+ *	@param[in] budget		Maximum number of bytes to read
+ *	@return uint8_t			Number of bytes consumed
+ *	@date 19.10.26			First implementation					*/
+static uint8_t etheRgbSerial_ReadData(uint8_t budget)
+{
+	uint8_t* target = &LocalCommandDataBuffer[LocalCommandBuffer.dataLength];
+	uint8_t count = RequiredDataLength - LocalCommandBuffer.dataLength;
+
+	if (count > budget)
+	{
+		count = budget;
+	}
+	count = serialReadBuf(target, count, 0);
+
+	for (uint8_t i=0; i < count; ++i)
+	{
+		RunningChecksum += etheRgbCommand_CalculateEvenParity(target[i]);
+	}
+	LocalCommandBuffer.dataLength += count;
+
+	if (LocalCommandBuffer.dataLength == RequiredDataLength)
+	{
+		// Data section complete
+		SerialStateMachine = STATE_GOT_DATA;
+	}
+
+	return count;
+}
+
+/*!	@brief Feed a single protocol byte into the receive state machine
+ *
+ *	@param[in] data			Received byte
+ *	@return etheRgbSource_t	SOURCE_SERIAL, if the packet is complete
+ *	@date 11.07.17			Rework
+ *	@date 19.10.26			Split from etheRgbSerial_Poll,
+ *							incremental checksum					*/
+static etheRgbSource_t etheRgbSerial_ProcessByte(uint8_t data)
+{
+	switch (SerialStateMachine)
+	{
+		case STATE_IDLE:
+			if (data == ETHERGB_START_BYTE)
+			{
+				// Advance to next state
+				SerialStateMachine = STATE_GOT_START_BYTE;
+				RunningChecksum = etheRgbCommand_CalculateEvenParity(data);
+
+				// No complete packet, yet
+				return SOURCE_NONE;
+			}
+			else
+			{	
+				LOG_EVENT(SRC_ETHERGB, LOG_EVT_SERIAL_INVALID_START, data);
+				etheRgbSerial_Reset();
+
+				return SOURCE_NONE;
+			}
+		case STATE_GOT_START_BYTE:
+			if (etheRgbCommand_HasCommand(data))
+			{
+				// Copy command to local buffer
+				LocalCommandBuffer.commandType = data;
+				RunningChecksum += etheRgbCommand_CalculateEvenParity(data);
+
+				// Advance to next state
+				RequiredDataLength = etheRgbCommand_GetRequiredDataLength(data);
+				SerialStateMachine = (RequiredDataLength > 0) ? STATE_GOT_COMMAND_BYTE_READ_DATA : STATE_GOT_DATA;
+
+				// No complete packet, yet
+				return SOURCE_NONE;
+			}
+			else
+			{
+				LOG_EVENT(SRC_ETHERGB, LOG_EVT_SERIAL_INVALID_COMMAND, data);
+				etheRgbSerial_Reset();
+
+				return SOURCE_NONE;
+			}
+		case STATE_GOT_DATA:
+			if (data == RunningChecksum)
+			{
+				// Data is complete - copy to shared buffer
+				SharedCommandBuffer->commandType = LocalCommandBuffer.commandType;
+				for (register uint8_t i=0; i<LocalCommandBuffer.dataLength; ++i)
+				{
+					SharedCommandBuffer->data[i] = LocalCommandBuffer.data[i];
+				}
+				SharedCommandBuffer->dataLength = LocalCommandBuffer.dataLength;
+				SharedCommandBuffer->source = LocalCommandBuffer.source;
+
+				// Clear old data
+				etheRgbSerial_Reset();
+
+				// Got a complete packet
+				return SOURCE_SERIAL;
+			}
+			else
+			{
+				LOG_EVENT(SRC_ETHERGB, LOG_EVT_SERIAL_INVALID_CHECKSUM, ((uint16_t)data << 8) | RunningChecksum);
+				etheRgbSerial_Reset();
+
+				return SOURCE_NONE;
+			}
+		default:
+			LOG_CRASH(SRC_ETHERGB, "Invalid state machine state.");
+	}
+
+	return SOURCE_NONE;
+}
+
 /*!	@brief Serial module polling function
  *
  *	This method gets called periodically by the state machine, and
- *	reads any incoming data into the local command buffer.
+ *	reads all incoming data (up to ETHERGB_SERIAL_POLL_BUDGET bytes)
+ *	into the local command buffer. Parsing stops after a complete
+ *	packet, remaining data is kept for the next poll.
  *	Incoming data will be checked for protocol/checksum errors on
  *	the fly
  *
- *	@date 11.07.17			Rework									
+ *	@date 11.07.17			Rework
+ *	@date 19.10.26			Drain all available bytes per poll
  *	@return	etheRgbSource	SOURCE_SERIAL, if a complete packet was
  *							received.								*/
 etheRgbSource_t etheRgbSerial_Poll(void)
@@ -81,83 +210,22 @@ etheRgbSource_t etheRgbSerial_Poll(void)
 	{
 		TimeoutCounter = 0;
 
-		uint8_t data = serialRead();
-		switch (SerialStateMachine)
+		uint8_t budget = ETHERGB_SERIAL_POLL_BUDGET;
+		while ((budget > 0) && serialAvailable())
 		{
-			case STATE_IDLE:
-				if (data == ETHERGB_START_BYTE)
-				{
-					// Advance to next state
-					SerialStateMachine = STATE_GOT_START_BYTE;
-
-					// No complete packet, yet
-					return SOURCE_NONE;
-				}
-				else
-				{	
-					LOG_MESSAGE(SRC_ETHERGB, "Got invalid start byte.");
-					etheRgbSerial_Reset();
-
-					return SOURCE_NONE;
-				}
-			case STATE_GOT_START_BYTE:
-				if (etheRgbCommand_HasCommand(data))
-				{
-					// Copy command to local buffer
-					LocalCommandBuffer.commandType = data;
-
-					// Advance to next state
-					SerialStateMachine = (etheRgbCommand_GetRequiredDataLength(data) > 0) ? STATE_GOT_COMMAND_BYTE_READ_DATA : STATE_GOT_DATA;
-
-					// No complete packet, yet
-					return SOURCE_NONE;
-				}
-				else
-				{
-					LOG_MESSAGE(SRC_ETHERGB, "Got invalid command byte.");
-					etheRgbSerial_Reset();
-
-					return SOURCE_NONE;
-				}
-			case STATE_GOT_COMMAND_BYTE_READ_DATA:
-				LocalCommandDataBuffer[LocalCommandBuffer.dataLength] = data;
-				++LocalCommandBuffer.dataLength;
-
-				if (LocalCommandBuffer.dataLength == etheRgbCommand_GetRequiredDataLength(LocalCommandBuffer.commandType))
-				{
-					// Data section complete
-					SerialStateMachine = STATE_GOT_DATA;
-				}
-
-				// No complete packet, yet
-				return SOURCE_NONE;
-			case STATE_GOT_DATA:
-				if (data == etheRgbCommand_CalculateChecksum(&LocalCommandBuffer))
+			if (SerialStateMachine == STATE_GOT_COMMAND_BYTE_READ_DATA)
+			{
+				budget -= etheRgbSerial_ReadData(budget);
+			}
+			else
+			{
+				--budget;
+				if (etheRgbSerial_ProcessByte(serialRead()) == SOURCE_SERIAL)
 				{
-					// Data is complete - copy to shared buffer
-					SharedCommandBuffer->commandType = LocalCommandBuffer.commandType;
-					for (register uint8_t i=0; i<LocalCommandBuffer.dataLength; ++i)
-					{
-						SharedCommandBuffer->data[i] = LocalCommandBuffer.data[i];
-					}
-					SharedCommandBuffer->dataLength = LocalCommandBuffer.dataLength;
-					SharedCommandBuffer->source = LocalCommandBuffer.source;
-
-					// Clear old data
-					etheRgbSerial_Reset();
-
-					// Got a complete packet
+					// Shared buffer is occupied until the command ran
 					return SOURCE_SERIAL;
 				}
-				else
-				{
-					LOG_MESSAGE(SRC_ETHERGB, "Got invalid checksum.");
-					etheRgbSerial_Reset();
-
-					return SOURCE_NONE;
-				}
-			default:
-				LOG_CRASH(SRC_ETHERGB, "Invalid state machine state.");
+			}
 		}
 	}
 	else
@@ -168,7 +236,7 @@ etheRgbSource_t etheRgbSerial_Poll(void)
 			if (SerialStateMachine != STATE_IDLE)
 			{
 				// Serial connection timed out
-				LOG_MESSAGE(SRC_ETHERGB, "Serial connection timed out.");
+				LOG_EVENT(SRC_ETHERGB, LOG_EVT_SERIAL_TIMEOUT, SerialStateMachine);
 				etheRgbSerial_Reset();
 				return SOURCE_NONE;
 			}
@@ -179,9 +247,13 @@ etheRgbSource_t etheRgbSerial_Poll(void)
 }
 
 /*!	@brief Send response packet via serial connection
+ *
+ *	The packet is wrapped into a single frame on the protocol
+ *	channel, so it cannot be interleaved with log output.
  *
  *	@param[in] responseBuffer	Packet buffer to read data from
- *	@date 13.07.17			First implementation					*/
+ *	@date 13.07.17			First implementation
+ *	@date 19.10.26			Framed output							*/
 void etheRgbSerial_Send(etheRgbCommand_t* responseBuffer)
 {
 	if (responseBuffer == NULL)
@@ -194,8 +266,10 @@ void etheRgbSerial_Send(etheRgbCommand_t* responseBuffer)
 	uint8_t checksum = etheRgbCommand_CalculateChecksum(responseBuffer);
 
 	// Send data
-	serialWriteChar(ETHERGB_START_BYTE);
-	serialWriteChar(responseBuffer->commandType);
-	serialWriteBuf(responseBuffer->data, responseBuffer->dataLength, -1);
-	serialWriteChar(checksum);
+	serialFrameBegin(SERIAL_CHANNEL_PROTOCOL);
+	serialFramePut(ETHERGB_START_BYTE);
+	serialFramePut(responseBuffer->commandType);
+	serialFramePutBuf(responseBuffer->data, responseBuffer->dataLength);
+	serialFramePut(checksum);
+	serialFrameEnd();
 }
\ No newline at end of file
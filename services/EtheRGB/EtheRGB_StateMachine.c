@@ -7,17 +7,23 @@
  *	@date 25.06.17			Added command module
  *	@date 08.07.17			Reworked comms module
  *	@date 11.07.17			Restructuring
- *	@date 13.07.17			Added responses							*/
+ *	@date 13.07.17			Added responses
+ *	@date 19.10.26			Flush deferred log records when idle
+ *	@date 19.10.26			Show pixel frames when idle
+ *	@date 19.10.26			Scheduled commands first
+ *	@date 19.10.26			Named input selectors					*/
 
 #include <stdio.h>
 #include <stdint.h>
 #include "../../core/Ethernet/Ethernet.h"
 #include "../../core/Serial/Serial.h"
 #include "../../core/Log/Log.h"
+#include "../../core/Pixel/Pixel.h"
 #include "EtheRGB_Command.h"
 #include "EtheRGB_Serial.h"
 #include "EtheRGB_Ethernet.h"
 #include "EtheRGB_IO.h"
+#include "EtheRGB_Schedule.h"
 #include "EtheRGB_Dimmer.h"
 #include "EtheRGB_StateMachine.h"
 
@@ -27,10 +33,17 @@ typedef enum {
 	STATE_PROC
 } etheRgbStateMachineState_t;
 
+/*!	@brief Input sources, in polling order							*/
+typedef enum {
+	SELECT_IO,
+	SELECT_SERIAL,
+	SELECT_ETHERNET
+} etheRgbInputSelector_t;
+
 static etheRgbCommand_t* SharedCommandBuffer = NULL;
 static etheRgbCommand_t* SharedResponseBuffer = NULL;
 static etheRgbStateMachineState_t StateMachineState = STATE_UNINIT;
-static uint8_t DataInputSelector = 0;
+static uint8_t DataInputSelector = SELECT_IO;	//!< Next input source (etheRgbInputSelector_t)
 
 /*!	@brief Initialize the state machine
  *	
@@ -52,7 +65,7 @@ void etheRgbStateMachine_Init(etheRgbCommand_t* commandBuffer, etheRgbCommand_t*
  *	@date 11.07.17			Reworked								*/
 void etheRgbStateMachine_Reset(void)
 {
-	DataInputSelector = 0;
+	DataInputSelector = SELECT_IO;
 	StateMachineState = STATE_UNINIT;
 }
 
@@ -71,25 +84,39 @@ void etheRgbStateMachine_ClearBuffers()
 /*!	@brief State machine state: Idle
  *
  *	Device is waiting for incoming data. Input sources are queried
- *	in a round-robin fashion to prevent blocking by a single source
+ *	in a round-robin fashion to prevent blocking by a single source.
+ *	Due scheduled commands go first, so they run on time; there are
+ *	never more than ETHERGB_SCHEDULE_SLOTS of them.
  *
  *	@date 21.05.17			First implementation 
- *	@date 11.07.17			Reworked								*/
+ *	@date 11.07.17			Reworked
+ *	@date 19.10.26			Flush deferred log records when idle
+ *	@date 19.10.26			Show pixel frames when idle
+ *	@date 19.10.26			Scheduled commands first
+ *	@date 19.10.26			Named input selectors					*/
 void etheRgbStateMachine_IdleState(void)
 {
+	if (etheRgbSchedule_Poll() != SOURCE_NONE)
+	{
+		StateMachineState = STATE_PROC;
+		return;
+	}
+
+	uint8_t source = DataInputSelector;
+
 	switch (DataInputSelector)
 	{
-		case 0:
+		case SELECT_IO:
 			etheRgbIO_Poll();
 			break;
-		case 1:
+		case SELECT_SERIAL:
 			etheRgbSerial_Poll();
 			break;
-		case 2:
+		case SELECT_ETHERNET:
 			etheRgbEthernet_Poll();
 			break;
 		default:
-			DataInputSelector = 0;
+			DataInputSelector = SELECT_IO;
 			return;
 	}
 	++DataInputSelector;
@@ -99,6 +126,15 @@ void etheRgbStateMachine_IdleState(void)
 	{
 		StateMachineState = STATE_PROC;
 	}
+	else
+	{
+		// Nothing to do, send a pending log record
+		logFlush();
+
+		// Network drained, show pending pixel changes in one frame
+		if (source == SELECT_ETHERNET)
+			pixelShow();
+	}
 }
 
 /*!	@brief Process received command 
@@ -0,0 +1,415 @@
+/*!	@brief EtheRGB Effect VM module
+ *
+ *	A register machine interpreting the program in EEPROM byte by
+ *	byte, so programs take no RAM. Every ETHERGB_VM_TICK_MS, the
+ *	program runs until it yields, but for no more than
+ *	ETHERGB_VM_BUDGET instructions; a program that does not yield in
+ *	time simply continues in the next tick. So no program can starve
+ *	the network pollers or the dimmer.
+ *
+ *	Programs are sandboxed: register numbers are masked, and jumps out
+ *	of the program, invalid opcodes, division by zero and writes to
+ *	channels that do not exist stop the program with a fault.
+ *
+ *	Registers keep their values when a program is (re)started, so
+ *	effect parameters can be set before starting it.
+ *
+ *	@author	inselc
+ *	@date 19.10.26			First implementation					*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <avr/eeprom.h>
+#include <avr/pgmspace.h>
+#include "../../core/Clock/Clock.h"
+#include "../../core/Log/Log.h"
+#include "EtheRGB_Command.h"
+#include "EtheRGB_Dimmer.h"
+#include "EtheRGB_Vm.h"
+#include "EtheRGB_Config.h"
+
+#define VM_ONE			0x0100		/* 1.0 in Q8.8 */
+#define VM_TIME_PERIOD	256000UL	/* Period of the Q8.8 time register, in ms */
+
+/*!	@brief Sine, first quarter wave in 64 steps, 255 = 1.0			*/
+static const uint8_t VmSineTable[65] PROGMEM = {
+	0, 6, 13, 19, 25, 31, 37, 44, 50, 56, 62, 68, 74, 80, 86, 92,
+	98, 103, 109, 115, 120, 126, 131, 136, 142, 147, 152, 157, 162, 167, 171, 176,
+	180, 185, 189, 193, 197, 201, 205, 208, 212, 215, 219, 222, 225, 228, 231, 233,
+	236, 238, 240, 242, 244, 246, 247, 249, 250, 251, 252, 253, 254, 254, 255, 255,
+	255
+};
+
+static int16_t VmRegisters[ETHERGB_VM_REGISTERS];	//!< Q8.8 registers
+static uint8_t VmPc = 0;							//!< Program counter
+static etheRgbVmState_t VmState = VM_STATE_STOPPED;	//!< Program state
+static etheRgbVmFault_t VmFault = VM_FAULT_NONE;	//!< Fault that stopped the program
+static uint8_t VmSleep = 0;							//!< Ticks left to sleep
+static uint32_t VmStartTime = 0;					//!< Program start, in ms
+static uint32_t VmNextTick = 0;						//!< Next tick, in ms
+static uint16_t VmRandom = 0xACE1;					//!< Random generator state
+
+/*!	@brief Stop the program with a fault
+ *
+ *	@param[in] fault		Fault
+ *	@date 19.10.26			First implementation					*/
+static void etheRgbVm_Fault(etheRgbVmFault_t fault)
+{
+	VmFault = fault;
+	VmState = VM_STATE_FAULT;
+}
+
+/*!	@brief Fetch the next program byte
+ *
+ *	@return uint8_t			Program byte, VM_OP_HALT past the end
+ *	@date 19.10.26			First implementation					*/
+static uint8_t etheRgbVm_Fetch(void)
+{
+	if (VmPc >= ETHERGB_VM_PROGRAM_SIZE)
+	{
+		etheRgbVm_Fault(VM_FAULT_ADDRESS);
+		return VM_OP_HALT;
+	}
+	return eeprom_read_byte(&EtheRgbVmProgram[VmPc++]);
+}
+
+/*!	@brief Fetch a register operand
+ *
+ *	@return int16_t*		Register
+ *	@date 19.10.26			First implementation					*/
+static inline int16_t* etheRgbVm_FetchRegister(void)
+{
+	return &VmRegisters[etheRgbVm_Fetch() & (ETHERGB_VM_REGISTERS - 1)];
+}
+
+/*!	@brief Check, if all operands of an instruction were fetched
+ *
+ *	An instruction cut off by the end of the program has faulted in
+ *	etheRgbVm_Fetch, and must not be executed.
+ *
+ *	@return bool			true, if the program is still running
+ *	@date 19.10.26			First implementation					*/
+static inline bool etheRgbVm_OperandsFetched(void)
+{
+	return (VmState == VM_STATE_RUNNING);
+}
+
+/*!	@brief Jump to a program address
+ *
+ *	@param[in] address		Program address
+ *	@date 19.10.26			First implementation					*/
+static void etheRgbVm_Jump(uint8_t address)
+{
+	if (address >= ETHERGB_VM_PROGRAM_SIZE)
+	{
+		etheRgbVm_Fault(VM_FAULT_ADDRESS);
+		return;
+	}
+	VmPc = address;
+}
+
+/*!	@brief Sine of an angle
+ *
+ *	@param[in] turns		Angle, Q8.8 turns
+ *	@return int16_t			Sine, Q8.8
+ *	@date 19.10.26			First implementation					*/
+static int16_t etheRgbVm_Sine(int16_t turns)
+{
+	uint8_t angle = (uint8_t)turns;		// Fraction of a turn, 1/256
+	uint8_t step = angle & 0x3F;
+
+	if (angle & 0x40)
+		step = 64 - step;
+
+	int16_t value = pgm_read_byte(&VmSineTable[step]);
+	return (angle & 0x80) ? -value : value;
+}
+
+/*!	@brief Execute a single instruction
+ *
+ *	@return bool			false, if the tick has ended
+ *	@date 19.10.26			First implementation
+ *	@date 19.10.26			Skip instructions cut off by the end
+ *	@date 19.10.26			TIME without overflow after hours		*/
+static bool etheRgbVm_Step(void)
+{
+	uint8_t opcode = etheRgbVm_Fetch();
+	int16_t* r;
+	int16_t* s;
+
+	switch (opcode)
+	{
+		case VM_OP_HALT:
+			if (VmState == VM_STATE_RUNNING)
+				VmState = VM_STATE_STOPPED;
+			return false;
+
+		case VM_OP_YIELD:
+			return false;
+
+		case VM_OP_WAIT:
+			VmSleep = etheRgbVm_Fetch();
+			if (!etheRgbVm_OperandsFetched())
+				VmSleep = 0;
+			return false;
+
+		case VM_OP_LDI:
+		{
+			r = etheRgbVm_FetchRegister();
+			int16_t value = (int16_t)((uint16_t)etheRgbVm_Fetch() << 8);
+			value |= etheRgbVm_Fetch();
+			if (!etheRgbVm_OperandsFetched())
+				return false;
+			*r = value;
+			break;
+		}
+
+		case VM_OP_MOV:
+			r = etheRgbVm_FetchRegister();
+			s = etheRgbVm_FetchRegister();
+			if (!etheRgbVm_OperandsFetched())
+				return false;
+			*r = *s;
+			break;
+
+		case VM_OP_ADD:
+			r = etheRgbVm_FetchRegister();
+			s = etheRgbVm_FetchRegister();
+			if (!etheRgbVm_OperandsFetched())
+				return false;
+			*r = (int16_t)((uint16_t)*r + (uint16_t)*s);
+			break;
+
+		case VM_OP_SUB:
+			r = etheRgbVm_FetchRegister();
+			s = etheRgbVm_FetchRegister();
+			if (!etheRgbVm_OperandsFetched())
+				return false;
+			*r = (int16_t)((uint16_t)*r - (uint16_t)*s);
+			break;
+
+		case VM_OP_MUL:
+			r = etheRgbVm_FetchRegister();
+			s = etheRgbVm_FetchRegister();
+			if (!etheRgbVm_OperandsFetched())
+				return false;
+			*r = (int16_t)(((int32_t)*r * *s) >> 8);
+			break;
+
+		case VM_OP_DIV:
+			r = etheRgbVm_FetchRegister();
+			s = etheRgbVm_FetchRegister();
+			if (!etheRgbVm_OperandsFetched())
+				return false;
+			if (*s == 0)
+			{
+				etheRgbVm_Fault(VM_FAULT_DIVISION);
+				return false;
+			}
+			*r = (int16_t)(((int32_t)*r << 8) / *s);
+			break;
+
+		case VM_OP_SIN:
+			r = etheRgbVm_FetchRegister();
+			s = etheRgbVm_FetchRegister();
+			if (!etheRgbVm_OperandsFetched())
+				return false;
+			*r = etheRgbVm_Sine(*s);
+			break;
+
+		case VM_OP_RAND:
+			r = etheRgbVm_FetchRegister();
+			if (!etheRgbVm_OperandsFetched())
+				return false;
+			// 16 bit Galois LFSR
+			VmRandom = (VmRandom >> 1) ^ ((VmRandom & 0x01) ? 0xB400 : 0x0000);
+			*r = VmRandom & 0xFF;
+			break;
+
+		case VM_OP_TIME:
+		{
+			r = etheRgbVm_FetchRegister();
+			if (!etheRgbVm_OperandsFetched())
+				return false;
+			// Reduced to a register period first, so the shift cannot overflow
+			uint32_t elapsed = (clockMillis() - VmStartTime) % VM_TIME_PERIOD;
+			*r = (int16_t)((elapsed << 8) / 1000);
+			break;
+		}
+
+		case VM_OP_OUT:
+		{
+			r = etheRgbVm_FetchRegister();
+			s = etheRgbVm_FetchRegister();
+			if (!etheRgbVm_OperandsFetched())
+				return false;
+			uint8_t channel = (uint16_t)*r >> 8;
+			if (channel >= ETHERGB_MAX_OUTPUT_PINS)
+			{
+				etheRgbVm_Fault(VM_FAULT_CHANNEL);
+				return false;
+			}
+			int16_t value = *s;
+			if (value < 0)
+				value = 0;
+			else if (value > VM_ONE)
+				value = VM_ONE;
+			etheRgbDimmer_SetChannelValue(channel, (uint8_t)(((uint16_t)value * 0xFF) >> 8));
+			break;
+		}
+
+		case VM_OP_JMP:
+		{
+			uint8_t address = etheRgbVm_Fetch();
+			if (!etheRgbVm_OperandsFetched())
+				return false;
+			etheRgbVm_Jump(address);
+			break;
+		}
+
+		case VM_OP_JZ:
+		{
+			r = etheRgbVm_FetchRegister();
+			uint8_t address = etheRgbVm_Fetch();
+			if (!etheRgbVm_OperandsFetched())
+				return false;
+			if (*r == 0)
+				etheRgbVm_Jump(address);
+			break;
+		}
+
+		case VM_OP_JLT:
+		{
+			r = etheRgbVm_FetchRegister();
+			s = etheRgbVm_FetchRegister();
+			uint8_t address = etheRgbVm_Fetch();
+			if (!etheRgbVm_OperandsFetched())
+				return false;
+			if (*r < *s)
+				etheRgbVm_Jump(address);
+			break;
+		}
+
+		default:
+			etheRgbVm_Fault(VM_FAULT_OPCODE);
+			return false;
+	}
+
+	return (VmState == VM_STATE_RUNNING);
+}
+
+/*!	@brief Initialize the VM module
+ *
+ *	@date 19.10.26			First implementation					*/
+void etheRgbVm_Init(void)
+{
+	for (uint8_t i = 0; i < ETHERGB_VM_REGISTERS; ++i)
+	{
+		VmRegisters[i] = 0;
+	}
+	VmState = VM_STATE_STOPPED;
+	VmFault = VM_FAULT_NONE;
+}
+
+/*!	@brief VM polling routine
+ *
+ *	Runs one tick of the program, when due.
+ *
+ *	@date 19.10.26			First implementation					*/
+void etheRgbVm_Poll(void)
+{
+	if (VmState != VM_STATE_RUNNING)
+		return;
+
+	uint32_t now = clockMillis();
+	if ((int32_t)(now - VmNextTick) < 0)
+		return;
+
+	// Skip missed ticks instead of catching up
+	VmNextTick += ETHERGB_VM_TICK_MS;
+	if ((int32_t)(now - VmNextTick) >= 0)
+		VmNextTick = now + ETHERGB_VM_TICK_MS;
+
+	if (VmSleep > 0)
+	{
+		--VmSleep;
+		return;
+	}
+
+	for (uint8_t budget = ETHERGB_VM_BUDGET; budget > 0; --budget)
+	{
+		if (!etheRgbVm_Step())
+			break;
+	}
+}
+
+/*!	@brief Write program bytes to EEPROM
+ *
+ *	Stops a running program.
+ *
+ *	@param[in] offset		Program address
+ *	@param[in] *data		Program bytes
+ *	@param[in] length		Number of bytes
+ *	@return bool			false, if the range is out of the program
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbVm_WriteProgram(uint8_t offset, const uint8_t* data, uint8_t length)
+{
+	if ((offset >= ETHERGB_VM_PROGRAM_SIZE) || (length > ETHERGB_VM_PROGRAM_SIZE - offset) || (data == NULL))
+		return false;
+
+	etheRgbVm_Stop();
+	eeprom_update_block(data, &EtheRgbVmProgram[offset], length);
+	return true;
+}
+
+/*!	@brief Start the program from its beginning
+ *
+ *	@date 19.10.26			First implementation					*/
+void etheRgbVm_Start(void)
+{
+	VmPc = 0;
+	VmSleep = 0;
+	VmFault = VM_FAULT_NONE;
+	VmStartTime = clockMillis();
+	VmNextTick = VmStartTime;
+	VmState = VM_STATE_RUNNING;
+}
+
+/*!	@brief Stop the program
+ *
+ *	The channels keep their values.
+ *
+ *	@date 19.10.26			First implementation					*/
+void etheRgbVm_Stop(void)
+{
+	if (VmState == VM_STATE_RUNNING)
+		VmState = VM_STATE_STOPPED;
+}
+
+/*!	@brief Set a register, e.g. an effect parameter
+ *
+ *	@param[in] reg			Register number
+ *	@param[in] value		Q8.8 value
+ *	@return bool			false, if the register number is out of bounds
+ *	@date 19.10.26			First implementation					*/
+bool etheRgbVm_SetRegister(uint8_t reg, int16_t value)
+{
+	if (reg >= ETHERGB_VM_REGISTERS)
+		return false;
+
+	VmRegisters[reg] = value;
+	return true;
+}
+
+/*!	@brief Get the program state
+ *
+ *	@param[out] *pc			Program counter
+ *	@param[out] *fault		Fault, if stopped by one (etheRgbVmFault_t)
+ *	@return uint8_t			State (etheRgbVmState_t)
+ *	@date 19.10.26			First implementation					*/
+uint8_t etheRgbVm_GetState(uint8_t* pc, uint8_t* fault)
+{
+	*pc = VmPc;
+	*fault = VmFault;
+	return VmState;
+}
@@ -0,0 +1,75 @@
+/*!	@brief EtheRGB Effect VM module
+ *
+ *	Runs small effect programs (breathing, rainbow, twinkle, strobe)
+ *	on the device, so the effects need no stream of frames.
+ *
+ *	@author	inselc
+ *	@date 19.10.26			First implementation					*/
+
+#ifndef ETHERGB_VM_H_
+#define ETHERGB_VM_H_
+
+/*!	@file */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ETHERGB_VM_PROGRAM_SIZE		96		/* Program bytes, in EEPROM */
+#define ETHERGB_VM_REGISTERS		8		/* Q8.8 registers */
+#define ETHERGB_VM_TICK_MS			20		/* Tick period */
+#define ETHERGB_VM_BUDGET			64		/* Instructions per tick */
+#define ETHERGB_VM_DATA_LENGTH		12		/* Program bytes per upload command */
+
+/*!	@enum etheRgbVmOpcode_t
+ *	@brief Instruction set
+ *
+ *	Registers hold signed Q8.8 fixed point numbers (0x0100 = 1.0).
+ *	Operands follow the opcode: r, s are register numbers (one byte
+ *	each), a is a program address, n a byte, i a 16 bit immediate,
+ *	MSB first. Arithmetic wraps around.							*/
+typedef enum {
+	VM_OP_HALT = 0x00,		//!< Stop the program
+	VM_OP_YIELD = 0x01,		//!< End the tick
+	VM_OP_WAIT = 0x02,		//!< n: end the tick, sleep for n more ticks
+	VM_OP_LDI = 0x03,		//!< r i: r = i
+	VM_OP_MOV = 0x04,		//!< r s: r = s
+	VM_OP_ADD = 0x05,		//!< r s: r = r + s
+	VM_OP_SUB = 0x06,		//!< r s: r = r - s
+	VM_OP_MUL = 0x07,		//!< r s: r = r * s
+	VM_OP_DIV = 0x08,		//!< r s: r = r / s, fault if s is 0
+	VM_OP_SIN = 0x09,		//!< r s: r = sin(s), s in turns (1.0 = 360 degrees)
+	VM_OP_RAND = 0x0A,		//!< r: r = random number, 0 <= r < 1.0
+	VM_OP_TIME = 0x0B,		//!< r: r = time since start, in seconds (wraps after 128s)
+	VM_OP_OUT = 0x0C,		//!< r s: set channel int(r) to s, 0..1.0 full range
+	VM_OP_JMP = 0x0D,		//!< a: jump to a
+	VM_OP_JZ = 0x0E,		//!< r a: jump to a, if r is 0
+	VM_OP_JLT = 0x0F		//!< r s a: jump to a, if r < s
+} etheRgbVmOpcode_t;
+
+/*!	@enum etheRgbVmState_t
+ *	@brief Program states											*/
+typedef enum {
+	VM_STATE_STOPPED = 0,	//!< Not started, or halted
+	VM_STATE_RUNNING = 1,	//!< Running
+	VM_STATE_FAULT = 2		//!< Stopped by a fault, see etheRgbVmFault_t
+} etheRgbVmState_t;
+
+/*!	@enum etheRgbVmFault_t
+ *	@brief Program faults											*/
+typedef enum {
+	VM_FAULT_NONE = 0,
+	VM_FAULT_OPCODE = 1,	//!< Invalid opcode
+	VM_FAULT_ADDRESS = 2,	//!< Program counter out of the program
+	VM_FAULT_DIVISION = 3,	//!< Division by zero
+	VM_FAULT_CHANNEL = 4	//!< Channel out of bounds
+} etheRgbVmFault_t;
+
+void etheRgbVm_Init(void);
+void etheRgbVm_Poll(void);
+bool etheRgbVm_WriteProgram(uint8_t offset, const uint8_t* data, uint8_t length);
+void etheRgbVm_Start(void);
+void etheRgbVm_Stop(void);
+bool etheRgbVm_SetRegister(uint8_t reg, int16_t value);
+uint8_t etheRgbVm_GetState(uint8_t* pc, uint8_t* fault);
+
+#endif /* ETHERGB_VM_H_ */
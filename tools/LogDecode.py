@@ -0,0 +1,90 @@
+"""Decode deferred EtheRGB log records.
+
+The firmware only transmits (id, argument, timestamp) tuples for
+LOG_EVENT calls, as frames on the event channel (see SerialDemux.py).
+This script maps the ids back to the message texts listed in
+core/Log/LogEvents.h, and ignores all other channels.
+
+Records only carry the lower 16 bits of the millisecond clock, so
+decoded times stay consistent only while records are less than
+65.536 s apart. After a longer gap, the decoded
+times of all later records are short by a multiple of 65.536 s.
+
+Usage:
+    python tools/LogDecode.py capture.bin
+    python tools/LogDecode.py /dev/ttyUSB0 1000000   (requires pyserial)
+"""
+
+import io
+import os
+import re
+import sys
+
+RECORD_LENGTH = 5
+
+EVENTS_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                             '..', 'core', 'Log', 'LogEvents.h')
+
+
+def load_events(path=EVENTS_HEADER):
+    """Return the list of (name, text) tuples, indexed by event id."""
+    content = io.open(path, encoding='utf-8').read()
+    entries = re.findall(r'ENTRY\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)', content)
+    return [(name, text.encode('utf-8').decode('unicode_escape')) for name, text in entries]
+
+
+def format_event(events, event_id, arg):
+    if event_id >= len(events):
+        return 'Unknown event %d (arg 0x%04X)' % (event_id, arg)
+    name, text = events[event_id]
+    if '%' in text:
+        text = text % arg
+    return text
+
+
+class RecordDecoder(object):
+    """Decodes event record payloads."""
+
+    def __init__(self, events):
+        self.events = events
+        self.last_timestamp = None
+        self.time_offset = 0
+
+    def decode(self, record):
+        """Return (milliseconds, text), or None for a malformed record."""
+        record = bytearray(record)
+        if len(record) != RECORD_LENGTH:
+            return None
+        event_id = record[0]
+        arg = (record[1] << 8) | record[2]
+        timestamp = (record[3] << 8) | record[4]
+
+        # Unwrap the 16-bit millisecond timestamp; a gap of 65.536 s or
+        # more between two records cannot be told from a shorter one
+        if self.last_timestamp is not None and timestamp < self.last_timestamp:
+            self.time_offset += 0x10000
+        self.last_timestamp = timestamp
+
+        return (self.time_offset + timestamp, format_event(self.events, event_id, arg))
+
+
+def main(argv):
+    if len(argv) < 2:
+        sys.stderr.write(__doc__)
+        return 1
+
+    import SerialDemux
+
+    decoder = RecordDecoder(load_events())
+
+    for channel, payload in SerialDemux.read_frames(SerialDemux.open_source(argv)):
+        if channel != SerialDemux.CHANNEL_LOG_EVENT:
+            continue
+        decoded = decoder.decode(payload)
+        if decoded is not None:
+            sys.stdout.write('[%10.3f] %s\n' % (decoded[0] / 1000.0, decoded[1]))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -0,0 +1,105 @@
+"""Split the EtheRGB serial output into its channels.
+
+All device output is sent as COBS-encoded frames terminated by 0x00.
+The first byte of each decoded frame is the channel (see
+core/Serial/SerialFrame.h):
+
+    0x01  protocol packets ('A', command, data, checksum)
+    0x02  log messages (text)
+    0x03  deferred log event records (decoded via LogDecode)
+
+Usage:
+    python tools/SerialDemux.py capture.bin
+    python tools/SerialDemux.py /dev/ttyUSB0 1000000   (requires pyserial)
+"""
+
+import io
+import os
+import sys
+
+import LogDecode
+
+CHANNEL_PROTOCOL = 0x01
+CHANNEL_LOG_TEXT = 0x02
+CHANNEL_LOG_EVENT = 0x03
+
+
+def cobs_decode(data):
+    """Decode one COBS block sequence (without delimiter), None if malformed."""
+    decoded = bytearray()
+    index = 0
+    while index < len(data):
+        code = data[index]
+        if code == 0 or index + code > len(data):
+            return None
+        decoded.extend(data[index + 1:index + code])
+        index += code
+        if code < 0xFF and index < len(data):
+            decoded.append(0)
+    return decoded
+
+
+class FrameReader(object):
+    """Collects bytes and returns complete (channel, payload) frames."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+
+    def feed(self, data):
+        self.buffer.extend(bytearray(data))
+        frames = []
+        while True:
+            end = self.buffer.find(b'\x00')
+            if end < 0:
+                break
+            frame = cobs_decode(self.buffer[:end])
+            del self.buffer[:end + 1]
+            if frame:
+                frames.append((frame[0], bytes(frame[1:])))
+        return frames
+
+
+def open_source(argv):
+    """Open the capture file or serial port given on the command line."""
+    if os.path.isfile(argv[1]):
+        return io.open(argv[1], 'rb')
+    import serial
+    baudrate = int(argv[2]) if len(argv) > 2 else 1000000
+    return serial.Serial(argv[1], baudrate)
+
+
+def read_frames(source):
+    """Yield (channel, payload) tuples until the source is exhausted."""
+    reader = FrameReader()
+    while True:
+        data = source.read(1 if hasattr(source, 'in_waiting') else 4096)
+        if not data:
+            break
+        for frame in reader.feed(data):
+            yield frame
+
+
+def main(argv):
+    if len(argv) < 2:
+        sys.stderr.write(__doc__)
+        return 1
+
+    records = LogDecode.RecordDecoder(LogDecode.load_events())
+
+    for channel, payload in read_frames(open_source(argv)):
+        if channel == CHANNEL_PROTOCOL:
+            sys.stdout.write('PROTO %s\n' % ' '.join('%02X' % b for b in bytearray(payload)))
+        elif channel == CHANNEL_LOG_TEXT:
+            sys.stdout.write('LOG   %s\n' % payload.decode('ascii', 'replace').rstrip('\r\n'))
+        elif channel == CHANNEL_LOG_EVENT:
+            decoded = records.decode(payload)
+            if decoded is not None:
+                sys.stdout.write('EVENT [%10.3f] %s\n' % (decoded[0] / 1000.0, decoded[1]))
+        else:
+            sys.stdout.write('?%02X   %s\n' % (channel, ' '.join('%02X' % b for b in bytearray(payload))))
+        sys.stdout.flush()
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))